@@ -0,0 +1,183 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#include "bench.h"
+
+#include <slick/thread_affine_pool.h>
+
+#include <unordered_set>
+
+/**
+ * @file affine_bench.cpp
+ * @brief Per-thread working sets: shared ring vs thread-affine page segments
+ *
+ * @details
+ * Every thread holds --working objects. One operation replaces a random held
+ * object (free + allocate + write) and reads --touch random held objects.
+ * After --ops warm-up operations, so the working sets reach their steady
+ * spread, --ops operations are timed on each thread:
+ * - ring:   ObjectPool, objects come from anywhere in the buffer
+ * - affine: ThreadAffinePool with --segment byte segments
+ *
+ * Reports ns per operation (mean over threads) and the 4 KB pages a thread's
+ * working set spans at the end.
+ *
+ * Options:
+ *   --capacity=1048576   Objects in each pool (power of 2)
+ *   --payload=64         Object size in bytes (8..4096, powers of 2)
+ *   --threads=1,4        Thread counts
+ *   --working=4096       Objects held per thread
+ *   --touch=4            Held objects read per operation
+ *   --segment=4096       ThreadAffinePool segment size in bytes
+ *   --ops=1000000        Operations per thread (warm-up and timed each)
+ *   --repeat=3           Repetitions
+ */
+namespace {
+
+using namespace slick::bench;
+
+struct Rng {
+    uint64_t state;
+    explicit Rng(uint64_t seed) : state(seed * 0x9E3779B97F4A7C15ull + 1) {}
+    uint64_t operator()() noexcept {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+struct ThreadResult {
+    double ns_per_op = 0;
+    uint64_t pages = 0;
+};
+
+/**
+ * @brief Run the workload on one thread
+ */
+template<typename T, typename Pool>
+ThreadResult run_thread(Pool& pool, uint32_t thread, uint32_t working, uint32_t touch, uint64_t ops) {
+    Rng rng(thread + 1);
+    std::vector<T*> held(working);
+    for (auto& obj : held) {
+        obj = pool.allocate();
+    }
+    uint64_t sum = 0;
+    auto step = [&](uint64_t i) {
+        auto& victim = held[rng() % working];
+        pool.free(victim);
+        victim = pool.allocate();
+        victim->id = i;
+        for (uint32_t k = 0; k < touch; ++k) {
+            sum += held[rng() % working]->id;
+        }
+    };
+    for (uint64_t i = 0; i < ops; ++i) {
+        step(i);
+    }
+    auto start = clock::now();
+    for (uint64_t i = 0; i < ops; ++i) {
+        step(i);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+    do_not_optimize(sum);
+
+    ThreadResult result;
+    result.ns_per_op = static_cast<double>(elapsed) / static_cast<double>(ops);
+    std::unordered_set<uintptr_t> pages;
+    for (auto* obj : held) {
+        pages.insert(reinterpret_cast<uintptr_t>(obj) >> 12);
+    }
+    result.pages = pages.size();
+    for (auto* obj : held) {
+        pool.free(obj);
+    }
+    return result;
+}
+
+template<typename T, typename Pool>
+void measure(Pool& pool, const ThreadPlan& plan, uint32_t threads, uint32_t working, uint32_t touch, uint64_t ops,
+    std::vector<double>& ns, std::vector<double>& pages) {
+    std::vector<ThreadResult> results(threads);
+    run_threads(threads, plan, [&](uint32_t t) {
+        results[t] = run_thread<T>(pool, t, working, touch, ops);
+    });
+    double total_ns = 0;
+    double total_pages = 0;
+    for (auto& result : results) {
+        total_ns += result.ns_per_op;
+        total_pages += static_cast<double>(result.pages);
+    }
+    ns.push_back(total_ns / threads);
+    pages.push_back(total_pages / threads);
+}
+
+template<size_t N>
+void run_config(const Options& opts, Reporter& reporter, uint32_t threads) {
+    using Object = Payload<N>;
+    const ThreadPlan plan = ThreadPlan::from(opts);
+    const uint32_t capacity = static_cast<uint32_t>(opts.get_uint("capacity", 1048576));
+    const uint32_t working = static_cast<uint32_t>(std::max<uint64_t>(1, opts.get_uint("working", 4096)));
+    const uint32_t touch = static_cast<uint32_t>(opts.get_uint("touch", 4));
+    const uint32_t segment = static_cast<uint32_t>(opts.get_uint("segment", 4096));
+    const uint64_t ops = opts.get_uint("ops", 1000000);
+    const uint32_t repeat = static_cast<uint32_t>(std::max<uint64_t>(1, opts.get_uint("repeat", 3)));
+    if (capacity & (capacity - 1)) {
+        throw std::runtime_error("capacity must be a power of 2");
+    }
+    if (segment < N || (segment & (segment - 1))) {
+        throw std::runtime_error("segment must be a power of 2 no smaller than the payload");
+    }
+
+    auto ring = std::make_unique<slick::ObjectPool<Object>>(capacity);
+    auto affine = std::make_unique<slick::ThreadAffinePool<Object>>(capacity, segment);
+
+    std::vector<double> ring_ns, ring_pages, affine_ns, affine_pages;
+    for (uint32_t rep = 0; rep < repeat; ++rep) {
+        measure<Object>(*ring, plan, threads, working, touch, ops, ring_ns, ring_pages);
+        measure<Object>(*affine, plan, threads, working, touch, ops, affine_ns, affine_pages);
+    }
+
+    auto ring_summary = summarize(ring_ns);
+    auto affine_summary = summarize(affine_ns);
+    Record row;
+    row.add("suite", "affine")
+        .add("capacity", capacity)
+        .add("payload", N)
+        .add("threads", threads)
+        .add("working", working)
+        .add("touch", touch)
+        .add("segment", segment)
+        .add("repeat", repeat)
+        .add("ring_ns_per_op", ring_summary)
+        .add("affine_ns_per_op", affine_summary)
+        .add("ring_pages_per_thread", summarize(ring_pages).median)
+        .add("affine_pages_per_thread", summarize(affine_pages).median)
+        .add("speedup", affine_summary.median > 0 ? ring_summary.median / affine_summary.median : 0.0);
+    reporter.add(std::move(row));
+}
+
+void run_affine(const Options& opts, Reporter& reporter) {
+    for (auto payload : opts.get_uint_list("payload", "64")) {
+        for (auto threads : opts.get_uint_list("threads", "1,4")) {
+            bool known = dispatch_payload(payload, [&]<size_t N>() {
+                run_config<N>(opts, reporter, static_cast<uint32_t>(std::max<uint64_t>(1, threads)));
+            });
+            if (!known) {
+                throw std::runtime_error("unsupported payload size " + std::to_string(payload));
+            }
+        }
+    }
+}
+
+}   // namespace
+
+SLICK_BENCH_SUITE(affine, "per-thread working sets, shared ObjectPool ring vs ThreadAffinePool page segments", run_affine);
@@ -0,0 +1,582 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#pragma once
+
+#include <slick/object_pool.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+/**
+ * @file bench.h
+ * @brief Benchmark harness shared by all slick_object_pool_bench suites
+ *
+ * @details
+ * Provides command line parsing, thread pinning, a start barrier, statistical
+ * summaries and a reporter that prints a table and optionally writes JSON/CSV.
+ * Suites register themselves with SLICK_BENCH_SUITE and are selected with --suite.
+ */
+namespace slick::bench {
+
+using clock = std::chrono::steady_clock;
+
+/**
+ * @brief Command line options
+ * @details Every option is `--name=value`; lists are comma separated.
+ */
+class Options {
+    std::map<std::string, std::string> values_;
+
+public:
+    Options() = default;
+
+    Options(int argc, char** argv) {
+        for (int i = 1; i < argc; ++i) {
+            std::string_view arg = argv[i];
+            if (arg.substr(0, 2) != "--") {
+                throw std::runtime_error("unexpected argument " + std::string(arg));
+            }
+            arg.remove_prefix(2);
+            auto eq = arg.find('=');
+            std::string_view name = arg.substr(0, eq);
+            std::string_view value = eq == std::string_view::npos ? std::string_view("1") : arg.substr(eq + 1);
+            values_[std::string(name)] = std::string(value);
+        }
+    }
+
+    bool has(const std::string& name) const {
+        return values_.count(name) != 0;
+    }
+
+    std::string get(const std::string& name, const std::string& def) const {
+        auto it = values_.find(name);
+        return it == values_.end() ? def : it->second;
+    }
+
+    uint64_t get_uint(const std::string& name, uint64_t def) const {
+        auto it = values_.find(name);
+        return it == values_.end() ? def : std::stoull(it->second);
+    }
+
+    double get_double(const std::string& name, double def) const {
+        auto it = values_.find(name);
+        return it == values_.end() ? def : std::stod(it->second);
+    }
+
+    bool get_bool(const std::string& name, bool def) const {
+        auto it = values_.find(name);
+        if (it == values_.end()) {
+            return def;
+        }
+        return it->second == "1" || it->second == "true" || it->second == "on" || it->second == "yes";
+    }
+
+    std::vector<std::string> get_list(const std::string& name, const std::string& def) const {
+        std::vector<std::string> items;
+        std::stringstream ss(get(name, def));
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            if (!item.empty()) {
+                items.push_back(item);
+            }
+        }
+        return items;
+    }
+
+    std::vector<uint64_t> get_uint_list(const std::string& name, const std::string& def) const {
+        std::vector<uint64_t> items;
+        for (auto& item : get_list(name, def)) {
+            items.push_back(std::stoull(item));
+        }
+        return items;
+    }
+};
+
+// ============================================================================
+// CPU affinity
+// ============================================================================
+
+/**
+ * @brief CPUs the process is allowed to run on
+ * @return CPU ids in ascending order (at least one entry)
+ */
+inline std::vector<int> available_cpus() {
+    std::vector<int> cpus;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+#endif
+    if (cpus.empty()) {
+        unsigned n = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned cpu = 0; cpu < n; ++cpu) {
+            cpus.push_back(static_cast<int>(cpu));
+        }
+    }
+    return cpus;
+}
+
+/**
+ * @brief Pin the calling thread to a CPU
+ * @return false if pinning is not supported or was refused
+ */
+inline bool pin_current_thread(int cpu) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#elif defined(_WIN32)
+    return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu) != 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+// ============================================================================
+// Threads
+// ============================================================================
+
+/**
+ * @brief Spinning start barrier so all workers begin the measured region together
+ */
+class StartBarrier {
+    std::atomic<uint32_t> arrived_{ 0 };
+    uint32_t count_;
+
+public:
+    explicit StartBarrier(uint32_t count) : count_(count) {}
+
+    void arrive_and_wait() noexcept {
+        arrived_.fetch_add(1, std::memory_order_acq_rel);
+        while (arrived_.load(std::memory_order_acquire) < count_) {
+            std::this_thread::yield();
+        }
+    }
+};
+
+/**
+ * @brief Per-thread placement used by run_threads()
+ */
+struct ThreadPlan {
+    bool pin = true;            ///< Pin each worker to a CPU
+    std::vector<int> cpus;      ///< CPUs to use, worker i runs on cpus[i % cpus.size()]
+
+    static ThreadPlan from(const Options& opts) {
+        ThreadPlan plan;
+        plan.pin = !opts.get_bool("no-pin", false);
+        if (opts.has("cpus")) {
+            for (auto cpu : opts.get_uint_list("cpus", "")) {
+                plan.cpus.push_back(static_cast<int>(cpu));
+            }
+        } else {
+            plan.cpus = available_cpus();
+        }
+        return plan;
+    }
+
+    int cpu_of(uint32_t thread) const noexcept {
+        return cpus.empty() ? -1 : cpus[thread % cpus.size()];
+    }
+};
+
+/**
+ * @brief Run `fn(thread_index)` on `n` pinned threads released together
+ *
+ * @details
+ * Workers are created, pinned, and held on a barrier so thread start-up is not
+ * part of the measurement. Returns the wall time from release to the last join.
+ */
+template<typename Fn>
+std::chrono::nanoseconds run_threads(uint32_t n, const ThreadPlan& plan, Fn&& fn) {
+    StartBarrier barrier(n + 1);
+    std::vector<std::thread> threads;
+    threads.reserve(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        threads.emplace_back([&, i] {
+            if (plan.pin) {
+                pin_current_thread(plan.cpu_of(i));
+            }
+            barrier.arrive_and_wait();
+            fn(i);
+        });
+    }
+    barrier.arrive_and_wait();
+    auto start = clock::now();
+    for (auto& t : threads) {
+        t.join();
+    }
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start);
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+/**
+ * @brief Summary of repeated measurements
+ */
+struct Summary {
+    size_t count = 0;
+    double min = 0;
+    double max = 0;
+    double mean = 0;
+    double median = 0;
+    double stddev = 0;
+
+    /// Coefficient of variation (stddev / mean), a quick noise indicator
+    double cv() const noexcept {
+        return mean != 0 ? stddev / mean : 0;
+    }
+};
+
+/// Value at quantile q (0..1) of an ascending sorted sample, linear interpolation
+inline double quantile_sorted(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    double pos = q * (sorted.size() - 1);
+    auto lo = static_cast<size_t>(pos);
+    auto hi = std::min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (sorted[hi] - sorted[lo]) * (pos - lo);
+}
+
+inline Summary summarize(std::vector<double> samples) {
+    Summary s;
+    s.count = samples.size();
+    if (samples.empty()) {
+        return s;
+    }
+    std::sort(samples.begin(), samples.end());
+    s.min = samples.front();
+    s.max = samples.back();
+    s.median = quantile_sorted(samples, 0.5);
+    double sum = 0;
+    for (double v : samples) {
+        sum += v;
+    }
+    s.mean = sum / samples.size();
+    double sq = 0;
+    for (double v : samples) {
+        sq += (v - s.mean) * (v - s.mean);
+    }
+    s.stddev = samples.size() > 1 ? std::sqrt(sq / (samples.size() - 1)) : 0;
+    return s;
+}
+
+/// Prevent the optimizer from discarding a value
+template<typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief Fixed-size payload used to sweep object sizes
+ */
+template<size_t N>
+struct Payload {
+    static_assert(N >= sizeof(uint64_t));
+    uint64_t id = 0;
+    std::array<char, N - sizeof(uint64_t)> data{};
+};
+
+/**
+ * @brief Invoke `fn.template operator()<N>()` for a runtime payload size
+ * @return false if `size` is not one of the compiled payload sizes
+ */
+template<typename Fn>
+bool dispatch_payload(size_t size, Fn&& fn) {
+    switch (size) {
+    case 8: fn.template operator()<8>(); return true;
+    case 16: fn.template operator()<16>(); return true;
+    case 32: fn.template operator()<32>(); return true;
+    case 64: fn.template operator()<64>(); return true;
+    case 128: fn.template operator()<128>(); return true;
+    case 256: fn.template operator()<256>(); return true;
+    case 512: fn.template operator()<512>(); return true;
+    case 1024: fn.template operator()<1024>(); return true;
+    case 2048: fn.template operator()<2048>(); return true;
+    case 4096: fn.template operator()<4096>(); return true;
+    default: return false;
+    }
+}
+
+/**
+ * @brief Append the CAS contention profile of a pool to a record
+ * @details Adds nothing unless compiled with SLICK_OBJECT_POOL_PROFILE_CAS
+ */
+template<typename Record, typename T>
+void add_cas_profile(Record& record, const slick::ObjectPool<T>& pool) {
+    if constexpr (slick::ObjectPool<T>::cas_profiling_enabled) {
+        auto profile = pool.cas_profile();
+        for (size_t i = 0; i < slick::CasProfile::SITE_COUNT; ++i) {
+            const auto& site = profile.sites[i];
+            std::string name = slick::CasProfile::site_name(i);
+            record.add(name + "_attempts", site.average_attempts());
+            record.add(name + "_retry_ns", site.operations ? double(site.retry_ns) / site.operations : 0.0);
+        }
+    }
+}
+
+// ============================================================================
+// Reporting
+// ============================================================================
+
+/**
+ * @brief One result row: ordered key/value pairs
+ */
+class Record {
+public:
+    using Value = std::variant<int64_t, double, std::string>;
+
+    Record& add(const std::string& key, Value value) {
+        fields_.emplace_back(key, std::move(value));
+        return *this;
+    }
+
+    Record& add(const std::string& key, const char* value) {
+        return add(key, Value(std::string(value)));
+    }
+
+    template<typename I>
+    requires std::is_integral_v<I>
+    Record& add(const std::string& key, I value) {
+        return add(key, Value(static_cast<int64_t>(value)));
+    }
+
+    /// Add mean/median/stddev/min/max/cv columns for a summary
+    Record& add(const std::string& prefix, const Summary& s) {
+        add(prefix + "_median", s.median);
+        add(prefix + "_mean", s.mean);
+        add(prefix + "_stddev", s.stddev);
+        add(prefix + "_min", s.min);
+        add(prefix + "_max", s.max);
+        add(prefix + "_cv", s.cv());
+        return *this;
+    }
+
+    const std::vector<std::pair<std::string, Value>>& fields() const noexcept {
+        return fields_;
+    }
+
+    static std::string to_string(const Value& value) {
+        std::ostringstream os;
+        std::visit([&](const auto& v) {
+            using V = std::decay_t<decltype(v)>;
+            if constexpr (std::is_same_v<V, double>) {
+                os << std::setprecision(6) << v;
+            } else {
+                os << v;
+            }
+        }, value);
+        return os.str();
+    }
+
+private:
+    std::vector<std::pair<std::string, Value>> fields_;
+};
+
+/**
+ * @brief Collects records, prints them and writes JSON/CSV on finish()
+ *
+ * @details
+ * Options: --json=<path>, --csv=<path>, --quiet (no per-row console output).
+ * Records of different suites may have different columns; the CSV header is
+ * the union of all keys in first-seen order.
+ */
+class Reporter {
+    std::string json_path_;
+    std::string csv_path_;
+    bool quiet_ = false;
+    std::vector<Record> records_;
+
+public:
+    explicit Reporter(const Options& opts)
+        : json_path_(opts.get("json", ""))
+        , csv_path_(opts.get("csv", ""))
+        , quiet_(opts.get_bool("quiet", false))
+    {}
+
+    void add(Record record) {
+        if (!quiet_) {
+            bool first = true;
+            for (auto& [key, value] : record.fields()) {
+                std::cout << (first ? "" : "  ") << key << "=" << Record::to_string(value);
+                first = false;
+            }
+            std::cout << std::endl;
+        }
+        records_.push_back(std::move(record));
+    }
+
+    const std::vector<Record>& records() const noexcept {
+        return records_;
+    }
+
+    void finish() const {
+        if (!json_path_.empty()) {
+            write_json(json_path_);
+        }
+        if (!csv_path_.empty()) {
+            write_csv(csv_path_);
+        }
+    }
+
+private:
+    static std::string escape(const std::string& s) {
+        std::string out;
+        for (char c : s) {
+            if (c == '"' || c == '\\') {
+                out += '\\';
+            }
+            out += c;
+        }
+        return out;
+    }
+
+    void write_json(const std::string& path) const {
+        std::ofstream out(path);
+        if (!out) {
+            throw std::runtime_error("cannot open " + path);
+        }
+        out << "{\n  \"meta\": {\"library_version\": \"" << SLICK_BENCH_VERSION << "\", \"compiler\": \""
+#if defined(__clang__)
+            << "clang " << __clang_major__ << "." << __clang_minor__
+#elif defined(__GNUC__)
+            << "gcc " << __GNUC__ << "." << __GNUC_MINOR__
+#elif defined(_MSC_VER)
+            << "msvc " << _MSC_VER
+#else
+            << "unknown"
+#endif
+            << "\", \"cas_profiling\": " << (slick::ObjectPool<int>::cas_profiling_enabled ? "true" : "false")
+            << ", \"hardware_concurrency\": " << std::thread::hardware_concurrency() << "},\n  \"results\": [\n";
+        for (size_t r = 0; r < records_.size(); ++r) {
+            out << "    {";
+            bool first = true;
+            for (auto& [key, value] : records_[r].fields()) {
+                out << (first ? "" : ", ") << "\"" << escape(key) << "\": ";
+                if (std::holds_alternative<std::string>(value)) {
+                    out << "\"" << escape(std::get<std::string>(value)) << "\"";
+                } else if (std::holds_alternative<double>(value) && !std::isfinite(std::get<double>(value))) {
+                    out << "null";
+                } else {
+                    out << Record::to_string(value);
+                }
+                first = false;
+            }
+            out << (r + 1 < records_.size() ? "},\n" : "}\n");
+        }
+        out << "  ]\n}\n";
+    }
+
+    void write_csv(const std::string& path) const {
+        std::ofstream out(path);
+        if (!out) {
+            throw std::runtime_error("cannot open " + path);
+        }
+        std::vector<std::string> columns;
+        for (auto& record : records_) {
+            for (auto& [key, value] : record.fields()) {
+                if (std::find(columns.begin(), columns.end(), key) == columns.end()) {
+                    columns.push_back(key);
+                }
+            }
+        }
+        for (size_t c = 0; c < columns.size(); ++c) {
+            out << (c ? "," : "") << columns[c];
+        }
+        out << "\n";
+        for (auto& record : records_) {
+            for (size_t c = 0; c < columns.size(); ++c) {
+                out << (c ? "," : "");
+                for (auto& [key, value] : record.fields()) {
+                    if (key == columns[c]) {
+                        out << Record::to_string(value);
+                        break;
+                    }
+                }
+            }
+            out << "\n";
+        }
+    }
+};
+
+// ============================================================================
+// Suite registry
+// ============================================================================
+
+/**
+ * @brief A named benchmark suite
+ */
+struct Suite {
+    const char* name;
+    const char* description;
+    void (*run)(const Options&, Reporter&);
+};
+
+inline std::vector<Suite>& suites() {
+    static std::vector<Suite> registry;
+    return registry;
+}
+
+struct SuiteRegistrar {
+    SuiteRegistrar(const char* name, const char* description, void (*run)(const Options&, Reporter&)) {
+        suites().push_back({ name, description, run });
+    }
+};
+
+/// Register a suite: SLICK_BENCH_SUITE(micro, "description", run_micro);
+#define SLICK_BENCH_SUITE(name, description, fn) \
+    static ::slick::bench::SuiteRegistrar slick_bench_suite_##name(#name, description, fn)
+
+}   // end namespace slick::bench
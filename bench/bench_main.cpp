@@ -0,0 +1,71 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#include "bench.h"
+
+namespace {
+
+void print_usage() {
+    std::cout << "Usage: slick_object_pool_bench [--suite=name[,name...]] [options]\n\n"
+              << "Common options:\n"
+              << "  --suite=<list>     Suites to run (default: micro, 'all' runs every suite)\n"
+              << "  --list             List suites\n"
+              << "  --json=<path>      Write results as JSON\n"
+              << "  --csv=<path>       Write results as CSV\n"
+              << "  --quiet            Do not print result rows\n"
+              << "  --no-pin           Do not pin threads to CPUs\n"
+              << "  --cpus=<list>      CPUs to pin threads to (default: process affinity)\n"
+              << "  --perf             Report hardware counters per operation (Linux perf_event_open)\n\n"
+              << "Suites:\n";
+    for (auto& suite : slick::bench::suites()) {
+        std::cout << "  " << std::left << std::setw(12) << suite.name << " " << suite.description << "\n";
+    }
+}
+
+}   // namespace
+
+int main(int argc, char** argv) {
+    using namespace slick::bench;
+    try {
+        Options opts(argc, argv);
+        if (opts.has("help") || opts.has("list")) {
+            print_usage();
+            return 0;
+        }
+
+        auto selected = opts.get_list("suite", "micro");
+        bool all = std::find(selected.begin(), selected.end(), "all") != selected.end();
+        for (auto& name : selected) {
+            if (name == "all") {
+                continue;
+            }
+            auto it = std::find_if(suites().begin(), suites().end(), [&](const Suite& s) { return name == s.name; });
+            if (it == suites().end()) {
+                std::cerr << "unknown suite: " << name << "\n";
+                print_usage();
+                return 1;
+            }
+        }
+
+        Reporter reporter(opts);
+        for (auto& suite : suites()) {
+            if (all || std::find(selected.begin(), selected.end(), suite.name) != selected.end()) {
+                std::cout << "# " << suite.name << ": " << suite.description << std::endl;
+                suite.run(opts, reporter);
+            }
+        }
+        reporter.finish();
+    } catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,292 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#include "bench.h"
+#include "histogram.h"
+#include "tsc.h"
+
+#include <slick/pool_replenisher.h>
+
+#include <deque>
+
+/**
+ * @file burst_bench.cpp
+ * @brief Market-open bursts: driving the pool past capacity and back
+ *
+ * @details
+ * Every thread keeps a FIFO of live objects; one operation frees the oldest
+ * and allocates a new one. Each run goes through three phases:
+ * - steady:   --ops operations at --steady * capacity live objects
+ * - burst:    the live objects ramp up to --overshoot * capacity (two
+ *             allocations per free), then --hold operations at that peak
+ * - recovery: the live objects ramp back down (two frees per allocation),
+ *             then up to --ops operations at the steady level
+ *
+ * Every allocate() and free() is timed with fenced rdtsc. Recovery ends with
+ * the first --window operations without heap objects whose mean cost is
+ * within --tolerance of the steady phase; the time from the end of the burst
+ * to that point is reported as recovery_ns (-1 if it was not reached).
+ *
+ * Modes, one per way the pool handles exhaustion:
+ * - heap:      ObjectPool(capacity), allocate() falls back to new T, free() deletes
+ * - grow:      ObjectPool(capacity, max_size, --segment), allocate() grows the pool
+ * - replenish: ObjectPool(capacity, max_size, 0) with a PoolReplenisher growing
+ *              it by --segment objects in the background
+ * max_size is twice the peak, rounded up to a power of 2.
+ *
+ * One row per mode, thread count and phase with allocate/free percentiles and
+ * heap fallbacks; recovery_ns and the final pool size are on every row.
+ *
+ * Options:
+ *   --modes=heap,grow,replenish
+ *   --threads=1,4        Thread counts
+ *   --capacity=65536     Initial pool capacity (power of 2)
+ *   --payload=64         Object size in bytes
+ *   --steady=0.5         Live objects in steady state, fraction of capacity
+ *   --overshoot=2.0      Live objects at the peak, multiple of capacity
+ *   --hold=200000        Operations per thread at the peak
+ *   --ops=200000         Operations per thread in the steady and recovery phases
+ *   --segment=4096       Growth segment of grow and replenish
+ *   --interval-us=100    Replenisher check interval
+ *   --window=1000        Operations per recovery check
+ *   --tolerance=1.5      Recovered when a window costs at most this times the steady mean
+ */
+namespace {
+
+using namespace slick::bench;
+
+enum Phase : size_t { STEADY, BURST, RECOVERY, PHASE_COUNT };
+
+constexpr const char* phase_name(size_t phase) noexcept {
+    constexpr const char* names[] = { "steady", "burst", "recovery" };
+    return names[phase];
+}
+
+struct PhaseStats {
+    LatencyHistogram allocate;
+    LatencyHistogram free;
+    uint64_t fallbacks = 0;     ///< Allocations served from the heap
+    uint64_t heap_frees = 0;    ///< Heap objects deleted by free()
+};
+
+struct ThreadResult {
+    PhaseStats phases[PHASE_COUNT];
+    double recovery_ns = -1;
+};
+
+struct Shape {
+    uint64_t steady_live;       ///< Live objects per thread in steady state
+    uint64_t peak_live;         ///< Live objects per thread at the peak
+    uint64_t hold;
+    uint64_t ops;
+    uint64_t window;
+    double tolerance;
+};
+
+/**
+ * @brief One thread's steady / burst / recovery run
+ */
+template<typename T>
+ThreadResult run_thread(slick::ObjectPool<T>& pool, const Shape& shape, StartBarrier& start) {
+    ThreadResult result;
+    std::deque<T*> live;
+    uint64_t window_ticks = 0;
+    uint64_t window_heap = 0;
+
+    auto allocate = [&](PhaseStats& stats) {
+        uint64_t s = Tsc::start();
+        T* obj = pool.allocate();
+        uint64_t e = Tsc::stop();
+        obj->id = live.size();
+        live.push_back(obj);
+        stats.allocate.record(e - s);
+        window_ticks += e - s;
+        if (!pool.owns(obj)) {
+            ++stats.fallbacks;
+            ++window_heap;
+        }
+    };
+    auto release = [&](PhaseStats& stats) {
+        T* obj = live.front();
+        live.pop_front();
+        const bool heap = !pool.owns(obj);
+        uint64_t s = Tsc::start();
+        pool.free(obj);
+        uint64_t e = Tsc::stop();
+        stats.free.record(e - s);
+        window_ticks += e - s;
+        if (heap) {
+            ++stats.heap_frees;
+            ++window_heap;
+        }
+    };
+
+    PhaseStats scratch;
+    while (live.size() < shape.steady_live) {
+        allocate(scratch);
+    }
+    start.arrive_and_wait();
+
+    auto& steady = result.phases[STEADY];
+    for (uint64_t i = 0; i < shape.ops; ++i) {
+        release(steady);
+        allocate(steady);
+    }
+    const double steady_mean = steady.allocate.mean() + steady.free.mean();
+
+    auto& burst = result.phases[BURST];
+    while (live.size() < shape.peak_live) {
+        allocate(burst);
+        allocate(burst);
+        release(burst);
+    }
+    for (uint64_t i = 0; i < shape.hold; ++i) {
+        release(burst);
+        allocate(burst);
+    }
+    const uint64_t burst_end = Tsc::start();
+
+    auto& recovery = result.phases[RECOVERY];
+    while (live.size() > shape.steady_live + 1) {
+        release(recovery);
+        release(recovery);
+        allocate(recovery);
+    }
+    window_ticks = 0;
+    window_heap = 0;
+    for (uint64_t i = 1; i <= shape.ops; ++i) {
+        release(recovery);
+        allocate(recovery);
+        if (i % shape.window == 0) {
+            const double mean = static_cast<double>(window_ticks) / static_cast<double>(shape.window);
+            if (result.recovery_ns < 0 && window_heap == 0 && mean <= shape.tolerance * steady_mean) {
+                result.recovery_ns = static_cast<double>(Tsc::to_ns(Tsc::stop() - burst_end));
+            }
+            window_ticks = 0;
+            window_heap = 0;
+        }
+    }
+
+    for (T* obj : live) {
+        pool.free(obj);
+    }
+    return result;
+}
+
+template<size_t N>
+void run_config(const Options& opts, Reporter& reporter, const std::string& mode, uint32_t threads) {
+    using T = Payload<N>;
+    const ThreadPlan plan = ThreadPlan::from(opts);
+    const uint32_t capacity = static_cast<uint32_t>(opts.get_uint("capacity", 65536));
+    const double steady = opts.get_double("steady", 0.5);
+    const double overshoot = opts.get_double("overshoot", 2.0);
+    const uint32_t segment = static_cast<uint32_t>(std::max<uint64_t>(1, opts.get_uint("segment", 4096)));
+    if (!capacity || (capacity & (capacity - 1))) {
+        throw std::runtime_error("capacity must be a power of 2");
+    }
+    if (steady <= 0 || steady >= 1 || overshoot <= steady) {
+        throw std::runtime_error("need 0 < steady < 1 and overshoot > steady");
+    }
+
+    Shape shape;
+    shape.steady_live = std::max<uint64_t>(1, static_cast<uint64_t>(capacity * steady / threads));
+    shape.peak_live = std::max(shape.steady_live + 1, static_cast<uint64_t>(capacity * overshoot / threads));
+    shape.hold = opts.get_uint("hold", 200000);
+    shape.ops = opts.get_uint("ops", 200000);
+    shape.window = std::max<uint64_t>(1, opts.get_uint("window", 1000));
+    shape.tolerance = opts.get_double("tolerance", 1.5);
+    const uint64_t peak = shape.peak_live * threads;
+    if (peak > (uint64_t(1) << 30)) {
+        throw std::runtime_error("peak too large");
+    }
+    const uint32_t max_size = std::max(capacity, 2 * std::bit_ceil(static_cast<uint32_t>(peak)));
+
+    std::unique_ptr<slick::ObjectPool<T>> pool;
+    std::unique_ptr<slick::PoolReplenisher> replenisher;
+    if (mode == "heap") {
+        pool = std::make_unique<slick::ObjectPool<T>>(capacity);
+    } else if (mode == "grow") {
+        pool = std::make_unique<slick::ObjectPool<T>>(capacity, max_size, segment);
+    } else if (mode == "replenish") {
+        pool = std::make_unique<slick::ObjectPool<T>>(capacity, max_size, 0);
+        replenisher = std::make_unique<slick::PoolReplenisher>(std::chrono::microseconds(opts.get_uint("interval-us", 100)));
+        replenisher->watch(*pool, { .segment_size = segment });
+        replenisher->start();
+    } else {
+        throw std::runtime_error("unknown mode " + mode);
+    }
+
+    std::vector<ThreadResult> results(threads);
+    StartBarrier start(threads);
+    run_threads(threads, plan, [&](uint32_t t) {
+        results[t] = run_thread(*pool, shape, start);
+    });
+    if (replenisher) {
+        replenisher->stop();
+    }
+
+    // Recovery is reached when the slowest thread reaches it
+    double recovery_ns = 0;
+    for (auto& result : results) {
+        recovery_ns = (recovery_ns < 0 || result.recovery_ns < 0) ? -1 : std::max(recovery_ns, result.recovery_ns);
+    }
+
+    for (size_t phase = 0; phase < PHASE_COUNT; ++phase) {
+        PhaseStats total;
+        for (auto& result : results) {
+            total.allocate.merge(result.phases[phase].allocate);
+            total.free.merge(result.phases[phase].free);
+            total.fallbacks += result.phases[phase].fallbacks;
+            total.heap_frees += result.phases[phase].heap_frees;
+        }
+        Record row;
+        row.add("suite", "burst")
+            .add("mode", mode)
+            .add("payload", N)
+            .add("capacity", capacity)
+            .add("threads", threads)
+            .add("phase", phase_name(phase))
+            .add("peak_live", peak)
+            .add("allocations", total.allocate.count())
+            .add("fallbacks", total.fallbacks)
+            .add("heap_frees", total.heap_frees);
+        for (auto [name, h] : { std::pair{ "allocate", &total.allocate }, std::pair{ "free", &total.free } }) {
+            for (double p : { 50.0, 99.0, 99.9 }) {
+                std::ostringstream key;
+                key << name << "_p" << p << "_ns";
+                row.add(key.str(), static_cast<double>(Tsc::to_ns(h->percentile(p))));
+            }
+            row.add(std::string(name) + "_max_ns", static_cast<double>(Tsc::to_ns(h->max())));
+        }
+        row.add("recovery_ns", recovery_ns)
+            .add("final_size", pool->size());
+        reporter.add(std::move(row));
+    }
+}
+
+void run_burst(const Options& opts, Reporter& reporter) {
+    auto payload = opts.get_uint("payload", 64);
+    std::cout << "# time source: " << Tsc::source() << ", " << Tsc::ns_per_tick() << " ns/tick" << std::endl;
+    for (auto& mode : opts.get_list("modes", "heap,grow,replenish")) {
+        for (auto threads : opts.get_uint_list("threads", "1,4")) {
+            bool known = dispatch_payload(payload, [&]<size_t N>() {
+                run_config<N>(opts, reporter, mode, static_cast<uint32_t>(std::max<uint64_t>(1, threads)));
+            });
+            if (!known) {
+                throw std::runtime_error("unsupported payload size " + std::to_string(payload));
+            }
+        }
+    }
+}
+
+}   // namespace
+
+SLICK_BENCH_SUITE(burst, "bursts past capacity and recovery: latency, heap fallbacks and time back to steady state per exhaustion mode", run_burst);
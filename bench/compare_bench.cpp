@@ -0,0 +1,341 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#include "bench.h"
+#include "histogram.h"
+#include "perf_counters.h"
+#include "tsc.h"
+
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+
+/**
+ * @file compare_bench.cpp
+ * @brief Identical workloads against slick::ObjectPool and standard allocators
+ *
+ * @details
+ * Allocators (all available without extra dependencies):
+ * - slick:    slick::ObjectPool<T>, shared by all threads
+ * - malloc:   std::malloc/std::free + placement new
+ * - new:      new T / delete
+ * - pmr_unsync: std::pmr::unsynchronized_pool_resource, one per thread
+ *             (it is not thread-safe; cross-thread frees are impossible)
+ * - pmr_sync: std::pmr::synchronized_pool_resource, shared by all threads
+ *
+ * Each configuration runs a throughput pass (untimed calls) and a latency pass
+ * (every call timed with fenced rdtsc into HDR-style histograms), then the suite
+ * prints a side-by-side table.
+ *
+ * Options:
+ *   --allocators=slick,malloc,new,pmr_unsync,pmr_sync
+ *   --mixes=alloc_free,batch,random
+ *   --threads=1,2,4
+ *   --payload=64
+ *   --pool-size=65536    slick pool capacity
+ *   --ops=200000         Operations per thread per pass
+ *   --batch=32           Objects held by batch/random mixes
+ *   --perf               Add hardware counters per operation of the throughput pass
+ */
+namespace {
+
+using namespace slick::bench;
+
+// ---------------------------------------------------------------------------
+// Allocator adapters: Shared is created once per run, Local once per thread
+// ---------------------------------------------------------------------------
+
+template<typename T>
+struct SlickAdapter {
+    static constexpr const char* name = "slick";
+    struct Shared {
+        slick::ObjectPool<T> pool;
+        explicit Shared(const Options& opts) : pool(static_cast<uint32_t>(opts.get_uint("pool-size", 65536))) {}
+    };
+    struct Local {
+        Shared& shared;
+        explicit Local(Shared& s) : shared(s) {}
+        T* allocate() { return shared.pool.allocate(); }
+        void free(T* p) { shared.pool.free(p); }
+    };
+};
+
+template<typename T>
+struct MallocAdapter {
+    static constexpr const char* name = "malloc";
+    struct Shared {
+        explicit Shared(const Options&) {}
+    };
+    struct Local {
+        explicit Local(Shared&) {}
+        T* allocate() {
+            void* p = std::malloc(sizeof(T));
+            if (!p) {
+                throw std::bad_alloc();
+            }
+            return new (p) T();
+        }
+        void free(T* p) {
+            p->~T();
+            std::free(p);
+        }
+    };
+};
+
+template<typename T>
+struct NewDeleteAdapter {
+    static constexpr const char* name = "new";
+    struct Shared {
+        explicit Shared(const Options&) {}
+    };
+    struct Local {
+        explicit Local(Shared&) {}
+        T* allocate() { return new T(); }
+        void free(T* p) { delete p; }
+    };
+};
+
+template<typename T>
+struct PmrUnsyncAdapter {
+    static constexpr const char* name = "pmr_unsync";
+    struct Shared {
+        explicit Shared(const Options&) {}
+    };
+    struct Local {
+        std::pmr::unsynchronized_pool_resource resource;
+        explicit Local(Shared&) {}
+        T* allocate() { return new (resource.allocate(sizeof(T), alignof(T))) T(); }
+        void free(T* p) {
+            p->~T();
+            resource.deallocate(p, sizeof(T), alignof(T));
+        }
+    };
+};
+
+template<typename T>
+struct PmrSyncAdapter {
+    static constexpr const char* name = "pmr_sync";
+    struct Shared {
+        std::pmr::synchronized_pool_resource resource;
+        explicit Shared(const Options&) {}
+    };
+    struct Local {
+        Shared& shared;
+        explicit Local(Shared& s) : shared(s) {}
+        T* allocate() { return new (shared.resource.allocate(sizeof(T), alignof(T))) T(); }
+        void free(T* p) {
+            p->~T();
+            shared.resource.deallocate(p, sizeof(T), alignof(T));
+        }
+    };
+};
+
+// ---------------------------------------------------------------------------
+// Workloads
+// ---------------------------------------------------------------------------
+
+/// No-op timer for the throughput pass
+struct NoTimer {
+    template<typename Fn>
+    auto alloc(Fn&& fn) { return fn(); }
+    template<typename Fn>
+    void free(Fn&& fn) { fn(); }
+};
+
+/// Per-call rdtsc timer for the latency pass
+struct TscTimer {
+    LatencyHistogram alloc_hist;
+    LatencyHistogram free_hist;
+
+    template<typename Fn>
+    auto alloc(Fn&& fn) {
+        uint64_t s = Tsc::start();
+        auto r = fn();
+        alloc_hist.record(Tsc::stop() - s);
+        return r;
+    }
+    template<typename Fn>
+    void free(Fn&& fn) {
+        uint64_t s = Tsc::start();
+        fn();
+        free_hist.record(Tsc::stop() - s);
+    }
+};
+
+template<typename T, typename Local, typename Timer>
+void run_workload(Local& a, Timer& timer, const std::string& mix, uint64_t ops, uint32_t batch, uint64_t seed, std::vector<T*>& held) {
+    auto alloc = [&] { return timer.alloc([&] { return a.allocate(); }); };
+    auto release = [&](T* p) { timer.free([&] { a.free(p); }); };
+
+    if (mix == "alloc_free") {
+        for (uint64_t i = 0; i < ops; ++i) {
+            T* obj = alloc();
+            obj->id = i;
+            do_not_optimize(obj);
+            release(obj);
+        }
+    } else if (mix == "batch") {
+        for (uint64_t i = 0; i < ops; i += batch) {
+            for (uint32_t b = 0; b < batch; ++b) {
+                T* obj = alloc();
+                obj->id = i + b;
+                held.push_back(obj);
+            }
+            for (T* obj : held) {
+                release(obj);
+            }
+            held.clear();
+        }
+    } else if (mix == "random") {
+        uint64_t state = seed * 0x9E3779B97F4A7C15ull + 1;
+        uint64_t allocs = 0;
+        while (allocs < ops) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            if (held.size() < batch && ((state & 1) || held.empty())) {
+                T* obj = alloc();
+                obj->id = allocs++;
+                held.push_back(obj);
+            } else {
+                auto idx = (state >> 1) % held.size();
+                release(held[idx]);
+                held[idx] = held.back();
+                held.pop_back();
+            }
+        }
+        for (T* obj : held) {
+            release(obj);
+        }
+        held.clear();
+    } else {
+        throw std::runtime_error("unknown mix " + mix);
+    }
+}
+
+struct CompareRow {
+    std::string allocator;
+    std::string mix;
+    uint32_t threads;
+    double mops;
+    double alloc_p50, alloc_p99, alloc_p999, alloc_p9999;
+    double free_p50, free_p99, free_p999;
+};
+
+template<typename Adapter, typename T>
+CompareRow run_adapter(const Options& opts, Reporter& reporter, const std::string& mix, uint32_t threads) {
+    const uint64_t ops = opts.get_uint("ops", 200000);
+    const uint32_t batch = static_cast<uint32_t>(std::max<uint64_t>(1, opts.get_uint("batch", 32)));
+    const ThreadPlan plan = ThreadPlan::from(opts);
+
+    typename Adapter::Shared shared(opts);
+    std::vector<std::chrono::nanoseconds> busy(threads);
+    std::vector<TscTimer> timers(threads);
+    PerfAggregate perf(opts.get_bool("perf", false));
+    run_threads(threads, plan, [&](uint32_t t) {
+        typename Adapter::Local local(shared);
+        std::vector<T*> held;
+        held.reserve(batch);
+        NoTimer none;
+        run_workload<T>(local, none, mix, ops / 10, batch, t + 1, held);     // warm-up
+        {
+            PerfAggregate::Region region(perf);
+            auto start = clock::now();
+            run_workload<T>(local, none, mix, ops, batch, t + 1, held);
+            busy[t] = clock::now() - start;
+        }
+        run_workload<T>(local, timers[t], mix, ops, batch, t + 1, held);
+    });
+
+    double slowest = 0;
+    for (auto& b : busy) {
+        slowest = std::max(slowest, static_cast<double>(b.count()));
+    }
+    LatencyHistogram alloc_hist, free_hist;
+    for (auto& timer : timers) {
+        alloc_hist.merge(timer.alloc_hist);
+        free_hist.merge(timer.free_hist);
+    }
+    auto ns = [](uint64_t ticks) { return static_cast<double>(Tsc::to_ns(ticks)); };
+
+    CompareRow row{ Adapter::name, mix, threads,
+        static_cast<double>(ops) * threads / slowest * 1e3,
+        ns(alloc_hist.percentile(50)), ns(alloc_hist.percentile(99)), ns(alloc_hist.percentile(99.9)), ns(alloc_hist.percentile(99.99)),
+        ns(free_hist.percentile(50)), ns(free_hist.percentile(99)), ns(free_hist.percentile(99.9)) };
+
+    Record record;
+    record.add("suite", "compare")
+        .add("allocator", row.allocator)
+        .add("payload", sizeof(T))
+        .add("mix", mix)
+        .add("threads", threads)
+        .add("ops", ops)
+        .add("mops", row.mops)
+        .add("alloc_p50_ns", row.alloc_p50)
+        .add("alloc_p99_ns", row.alloc_p99)
+        .add("alloc_p99.9_ns", row.alloc_p999)
+        .add("alloc_p99.99_ns", row.alloc_p9999)
+        .add("alloc_max_ns", ns(alloc_hist.max()))
+        .add("free_p50_ns", row.free_p50)
+        .add("free_p99_ns", row.free_p99)
+        .add("free_p99.9_ns", row.free_p999)
+        .add("free_max_ns", ns(free_hist.max()));
+    perf.add_to(record, static_cast<double>(ops) * threads);
+    reporter.add(std::move(record));
+    return row;
+}
+
+template<size_t N>
+void run_compare_payload(const Options& opts, Reporter& reporter) {
+    using T = Payload<N>;
+    auto allocators = opts.get_list("allocators", "slick,malloc,new,pmr_unsync,pmr_sync");
+    auto mixes = opts.get_list("mixes", "alloc_free,batch,random");
+    auto thread_counts = opts.get_uint_list("threads", "1,2,4");
+
+    std::vector<CompareRow> rows;
+    for (auto& mix : mixes) {
+        for (auto threads : thread_counts) {
+            auto t = static_cast<uint32_t>(threads);
+            for (auto& name : allocators) {
+                if (name == "slick") rows.push_back(run_adapter<SlickAdapter<T>, T>(opts, reporter, mix, t));
+                else if (name == "malloc") rows.push_back(run_adapter<MallocAdapter<T>, T>(opts, reporter, mix, t));
+                else if (name == "new") rows.push_back(run_adapter<NewDeleteAdapter<T>, T>(opts, reporter, mix, t));
+                else if (name == "pmr_unsync") rows.push_back(run_adapter<PmrUnsyncAdapter<T>, T>(opts, reporter, mix, t));
+                else if (name == "pmr_sync") rows.push_back(run_adapter<PmrSyncAdapter<T>, T>(opts, reporter, mix, t));
+                else throw std::runtime_error("unknown allocator " + name);
+            }
+        }
+    }
+
+    std::cout << "\n" << std::left << std::setw(12) << "allocator" << std::setw(12) << "mix" << std::right
+              << std::setw(8) << "threads" << std::setw(10) << "Mops/s"
+              << std::setw(10) << "a.p50" << std::setw(10) << "a.p99" << std::setw(10) << "a.p99.9" << std::setw(11) << "a.p99.99"
+              << std::setw(10) << "f.p50" << std::setw(10) << "f.p99" << std::setw(10) << "f.p99.9" << "   (ns, payload " << N << " B)\n";
+    std::cout << std::fixed << std::setprecision(1);
+    for (auto& r : rows) {
+        std::cout << std::left << std::setw(12) << r.allocator << std::setw(12) << r.mix << std::right
+                  << std::setw(8) << r.threads << std::setw(10) << r.mops
+                  << std::setw(10) << r.alloc_p50 << std::setw(10) << r.alloc_p99 << std::setw(10) << r.alloc_p999 << std::setw(11) << r.alloc_p9999
+                  << std::setw(10) << r.free_p50 << std::setw(10) << r.free_p99 << std::setw(10) << r.free_p999 << "\n";
+    }
+    std::cout << std::defaultfloat << std::endl;
+}
+
+void run_compare(const Options& opts, Reporter& reporter) {
+    auto payload = opts.get_uint("payload", 64);
+    if (!dispatch_payload(payload, [&]<size_t N>() { run_compare_payload<N>(opts, reporter); })) {
+        throw std::runtime_error("unsupported payload size " + std::to_string(payload));
+    }
+}
+
+}   // namespace
+
+SLICK_BENCH_SUITE(compare, "slick::ObjectPool vs malloc, new/delete and std::pmr pool resources", run_compare);
@@ -0,0 +1,213 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#include "bench.h"
+#include "perf_counters.h"
+
+/**
+ * @file descriptor_bench.cpp
+ * @brief Coherence cost of keeping the read-mostly descriptor next to the ring counters
+ *
+ * @details
+ * Every allocate() and free() reads the pool's descriptor (size, mask, lap
+ * shift, buffer, bounds, ring) and updates one of the two ring counters.
+ *
+ * The layout comparison is synthetic: it does not run ObjectPool, whose
+ * layout is fixed at compile time. It runs a stand-in for the pool's access
+ * pattern on two structs holding copies of the same fields:
+ * - synthetic_colocated: descriptor fields in the consumer counter's cache
+ *                        line, as ObjectPool had them; every consumer CAS
+ *                        invalidates them for all other cores, including
+ *                        producers that never touch it
+ * - synthetic_isolated:  descriptor on its own cache line, as ObjectPool has
+ *                        it now
+ *
+ * Each operation is one consume (descriptor + slot read, consumed CAS) and
+ * one publish (descriptor read + bounds check + reserved fetch_add + slot
+ * write). The stand-in leaves out everything else allocate() and free() do,
+ * so its speedup bounds what the layout change can give the pool rather
+ * than measuring it. The pool_current column runs allocate()/free() pairs
+ * on the real ObjectPool, i.e. the isolated layout only; there is no
+ * before-number for the real pool. With --perf, L1D/LLC misses per
+ * operation are reported for both synthetic layouts.
+ *
+ * Options:
+ *   --threads=1,2,4,8    Thread counts
+ *   --ring=1024          Ring slots (power of 2)
+ *   --ops=1000000        Operations per thread
+ *   --repeat=5           Repetitions
+ *   --perf               Hardware counters per layout
+ */
+namespace {
+
+using namespace slick::bench;
+
+#ifdef __cpp_lib_hardware_interference_size
+constexpr size_t LINE = std::hardware_destructive_interference_size;
+#else
+constexpr size_t LINE = 64;
+#endif
+
+/// The read-mostly fields allocate() and free() need
+struct Descriptor {
+    uint32_t size = 0;
+    uint32_t mask = 0;
+    uint32_t lap_shift = 0;
+    uint64_t* buffer = nullptr;
+    intptr_t lower_bound = 0;
+    intptr_t upper_bound = 0;
+    std::atomic_uint64_t* control = nullptr;
+};
+
+struct Colocated {
+    alignas(LINE) std::atomic_uint_fast64_t reserved{ 0 };
+    alignas(LINE) std::atomic_uint_fast64_t consumed{ 0 };
+    Descriptor descriptor;
+};
+
+struct Isolated {
+    alignas(LINE) Descriptor descriptor;
+    alignas(LINE) std::atomic_uint_fast64_t reserved{ 0 };
+    alignas(LINE) std::atomic_uint_fast64_t consumed{ 0 };
+};
+
+static_assert(sizeof(Descriptor) + sizeof(std::atomic_uint_fast64_t) <= LINE, "colocated layout must share one line");
+
+template<typename Layout>
+void init(Layout& layout, std::vector<uint64_t>& buffer, std::vector<std::atomic_uint64_t>& control) {
+    auto& d = layout.descriptor;
+    d.size = static_cast<uint32_t>(buffer.size());
+    d.mask = d.size - 1;
+    d.lap_shift = static_cast<uint32_t>(std::countr_zero(d.size));
+    d.buffer = buffer.data();
+    d.lower_bound = reinterpret_cast<intptr_t>(buffer.data());
+    d.upper_bound = reinterpret_cast<intptr_t>(buffer.data() + d.mask);
+    d.control = control.data();
+}
+
+/**
+ * @brief One thread's consume/publish loop on a layout
+ */
+template<typename Layout>
+void run_ops(Layout& layout, uint64_t ops) {
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < ops; ++i) {
+        // consume: counter, descriptor, slot, counter CAS
+        const auto& d = layout.descriptor;
+        uint64_t index = layout.consumed.load(std::memory_order_acquire);
+        uint64_t value;
+        do {
+            value = d.control[index & d.mask].load(std::memory_order_acquire);
+        } while (!layout.consumed.compare_exchange_weak(index, index + 1, std::memory_order_release, std::memory_order_relaxed));
+        uint64_t* obj = d.buffer + (value & d.mask);
+        sum += *obj;
+
+        // publish: descriptor, ownership check, counter fetch_add, slot
+        const auto& p = layout.descriptor;
+        const auto o = reinterpret_cast<intptr_t>(obj);
+        if (o >= p.lower_bound && o <= p.upper_bound) {
+            const uint64_t ring = layout.reserved.fetch_add(1, std::memory_order_relaxed);
+            p.control[ring & p.mask].store((ring >> p.lap_shift << 32) | uint64_t(obj - p.buffer), std::memory_order_release);
+        }
+    }
+    do_not_optimize(sum);
+}
+
+/**
+ * @brief Time ops operations on every thread
+ * @return Mean ns per operation over threads
+ */
+template<typename Body>
+double measure(uint32_t threads, const ThreadPlan& plan, uint64_t ops, PerfAggregate& perf, Body body) {
+    std::vector<double> ns(threads);
+    StartBarrier measured(threads);
+    run_threads(threads, plan, [&](uint32_t t) {
+        measured.arrive_and_wait();
+        PerfAggregate::Region region(perf);
+        auto start = clock::now();
+        body();
+        ns[t] = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count());
+    });
+    double total = 0;
+    for (double n : ns) {
+        total += n;
+    }
+    return total / (static_cast<double>(ops) * threads);
+}
+
+void run_config(const Options& opts, Reporter& reporter, uint32_t threads) {
+    const ThreadPlan plan = ThreadPlan::from(opts);
+    const uint32_t ring = static_cast<uint32_t>(opts.get_uint("ring", 1024));
+    const uint64_t ops = opts.get_uint("ops", 1000000);
+    const uint32_t repeat = static_cast<uint32_t>(std::max<uint64_t>(1, opts.get_uint("repeat", 5)));
+    const bool use_perf = opts.get_bool("perf", false);
+    if (!ring || (ring & (ring - 1))) {
+        throw std::runtime_error("ring must be a power of 2");
+    }
+
+    std::vector<uint64_t> buffer(ring);
+    std::vector<std::atomic_uint64_t> control(ring);
+    auto colocated = std::make_unique<Colocated>();
+    auto isolated = std::make_unique<Isolated>();
+    init(*colocated, buffer, control);
+    init(*isolated, buffer, control);
+    auto pool = std::make_unique<slick::ObjectPool<uint64_t>>(ring);
+
+    PerfAggregate colocated_perf(use_perf);
+    PerfAggregate isolated_perf(use_perf);
+    PerfAggregate pool_perf(false);
+    std::vector<double> colocated_ns, isolated_ns, pool_ns;
+    for (uint32_t rep = 0; rep < repeat; ++rep) {
+        colocated_ns.push_back(measure(threads, plan, ops, colocated_perf, [&] { run_ops(*colocated, ops); }));
+        isolated_ns.push_back(measure(threads, plan, ops, isolated_perf, [&] { run_ops(*isolated, ops); }));
+        pool_ns.push_back(measure(threads, plan, ops, pool_perf, [&] {
+            for (uint64_t i = 0; i < ops; ++i) {
+                uint64_t* obj = pool->allocate();
+                do_not_optimize(obj);
+                pool->free(obj);
+            }
+        }));
+    }
+
+    auto colocated_summary = summarize(colocated_ns);
+    auto isolated_summary = summarize(isolated_ns);
+    Record row;
+    row.add("suite", "descriptor")
+        .add("threads", threads)
+        .add("ring", ring)
+        .add("ops", ops)
+        .add("repeat", repeat)
+        .add("synthetic_colocated_ns_per_op", colocated_summary)
+        .add("synthetic_isolated_ns_per_op", isolated_summary)
+        .add("synthetic_speedup", isolated_summary.median > 0 ? colocated_summary.median / isolated_summary.median : 0.0)
+        .add("pool_current_ns_per_op", summarize(pool_ns).median);
+    const double total_ops = static_cast<double>(ops) * threads * repeat;
+    for (auto [prefix, perf] : { std::pair{ "synthetic_colocated_", &colocated_perf }, std::pair{ "synthetic_isolated_", &isolated_perf } }) {
+        Record counters;
+        perf->add_to(counters, total_ops);
+        for (auto& [key, value] : counters.fields()) {
+            row.add(prefix + key, value);
+        }
+    }
+    reporter.add(std::move(row));
+}
+
+void run_descriptor(const Options& opts, Reporter& reporter) {
+    std::cout << "# descriptor: synthetic_* columns run a stand-in for the pool's access pattern, not ObjectPool;"
+                 " pool_current is the real pool in its current layout" << std::endl;
+    for (auto threads : opts.get_uint_list("threads", "1,2,4,8")) {
+        run_config(opts, reporter, static_cast<uint32_t>(std::max<uint64_t>(1, threads)));
+    }
+}
+
+}   // namespace
+
+SLICK_BENCH_SUITE(descriptor, "synthetic model of the read-mostly descriptor next to vs apart from the ring counters, plus the current pool", run_descriptor);
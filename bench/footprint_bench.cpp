@@ -0,0 +1,117 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#include "bench.h"
+
+#include <fstream>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+/**
+ * @file footprint_bench.cpp
+ * @brief Bytes per object and resident memory of pools at large capacities
+ *
+ * @details
+ * For each payload size, capacity and pool layout, prints the accounting of
+ * ObjectPool::footprint() (payload, metadata, padding, bytes per object) and
+ * the growth of the process resident set while the pool exists. Pages of
+ * objects the constructor never writes stay non-resident until first use, so
+ * the RSS is measured twice: right after construction and after every object
+ * has been allocated and written once.
+ *
+ * RSS is read from /proc/self/statm and reported as 0 on other platforms.
+ *
+ * Options:
+ *   --sizes=8,64,256,1024    Payload sizes in bytes
+ *   --capacities=65536,1048576,4194304  Pool capacities
+ *   --layouts=ring           Pool layouts to measure
+ */
+namespace {
+
+using namespace slick::bench;
+
+int64_t resident_bytes() {
+#if defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+    int64_t size = 0, resident = 0;
+    if (statm >> size >> resident) {
+        return resident * sysconf(_SC_PAGESIZE);
+    }
+#endif
+    return 0;
+}
+
+template<size_t N>
+void measure_ring(Record& row, uint32_t capacity) {
+    using Pool = slick::ObjectPool<Payload<N>>;
+    const int64_t before = resident_bytes();
+    {
+        auto pool = std::make_unique<Pool>(capacity);
+        const int64_t constructed = resident_bytes();
+
+        std::vector<Payload<N>*> objects(capacity);
+        const int64_t with_vector = resident_bytes();
+        for (uint32_t i = 0; i < capacity; ++i) {
+            objects[i] = pool->allocate();
+            objects[i]->id = i;
+            objects[i]->data.fill(static_cast<char>(i));
+        }
+        const int64_t touched = resident_bytes() - (with_vector - constructed);
+        for (auto* obj : objects) {
+            pool->free(obj);
+        }
+
+        auto usage = pool->memory_usage();
+        row.add("payload_bytes", usage.payload_bytes)
+            .add("metadata_bytes", usage.metadata_bytes)
+            .add("padding_bytes", usage.padding_bytes)
+            .add("total_bytes", usage.total_bytes())
+            .add("bytes_per_object", usage.bytes_per_object())
+            .add("overhead_per_object", usage.overhead_per_object())
+            .add("rss_constructed_bytes", constructed - before)
+            .add("rss_touched_bytes", touched - before)
+            .add("rss_per_object", static_cast<double>(touched - before) / capacity);
+    }
+}
+
+void run_footprint(const Options& opts, Reporter& reporter) {
+    auto sizes = opts.get_uint_list("sizes", "8,64,256,1024");
+    auto capacities = opts.get_uint_list("capacities", "65536,1048576,4194304");
+    auto layouts = opts.get_list("layouts", "ring");
+
+    for (auto& layout : layouts) {
+        if (layout != "ring") {
+            throw std::runtime_error("unknown layout " + layout + " (available: ring)");
+        }
+    }
+
+    for (auto& layout : layouts) {
+        for (auto size : sizes) {
+            for (auto capacity : capacities) {
+                Record row;
+                row.add("suite", "footprint")
+                    .add("layout", layout)
+                    .add("payload", size)
+                    .add("capacity", capacity);
+                dispatch_payload(size, [&]<size_t N>() {
+                    measure_ring<N>(row, static_cast<uint32_t>(capacity));
+                });
+                reporter.add(std::move(row));
+            }
+        }
+    }
+}
+
+}   // namespace
+
+SLICK_BENCH_SUITE(footprint, "bytes per object and resident memory per layout at large capacities", run_footprint);
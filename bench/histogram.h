@@ -0,0 +1,205 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+#include <vector>
+
+namespace slick::bench {
+
+/**
+ * @brief HDR-style log-linear latency histogram
+ *
+ * @details
+ * Values below 2 * SUB_BUCKETS are recorded exactly; above that every power of
+ * two range is split into SUB_BUCKETS linear sub-buckets, bounding the relative
+ * error to 1 / SUB_BUCKETS (< 0.8 % with 128 sub-buckets) over the full uint64 range.
+ * Recording is a couple of shifts and one increment, so it can sit inside the
+ * measured loop. Histograms of different threads are combined with merge().
+ */
+class LatencyHistogram {
+public:
+    static constexpr uint32_t SUB_BUCKET_BITS = 7;
+    static constexpr uint64_t SUB_BUCKETS = uint64_t(1) << SUB_BUCKET_BITS;
+
+    LatencyHistogram()
+        : counts_((64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS, 0)
+    {}
+
+    void record(uint64_t value, uint64_t count = 1) noexcept {
+        counts_[index_of(value)] += count;
+        total_ += count;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+        sum_ += static_cast<double>(value) * count;
+    }
+
+    /**
+     * @brief Record with coordinated-omission correction
+     *
+     * @details
+     * When a measurement stalls for longer than the expected interval between
+     * requests, the requests that would have been issued during the stall are
+     * missing from the sample. Like HdrHistogram's recordValueWithExpectedInterval,
+     * this back-fills them with value - interval, value - 2 * interval, ...
+     *
+     * @param value Measured latency
+     * @param expected_interval Interval between requests at the offered rate (0 disables correction)
+     */
+    void record_corrected(uint64_t value, uint64_t expected_interval) noexcept {
+        record(value);
+        if (expected_interval == 0 || value <= expected_interval) {
+            return;
+        }
+        for (uint64_t missing = value - expected_interval; missing >= expected_interval; missing -= expected_interval) {
+            record(missing);
+        }
+    }
+
+    void merge(const LatencyHistogram& other) noexcept {
+        for (size_t i = 0; i < counts_.size(); ++i) {
+            counts_[i] += other.counts_[i];
+        }
+        total_ += other.total_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+        sum_ += other.sum_;
+    }
+
+    void clear() noexcept {
+        std::fill(counts_.begin(), counts_.end(), 0);
+        total_ = 0;
+        min_ = std::numeric_limits<uint64_t>::max();
+        max_ = 0;
+        sum_ = 0;
+    }
+
+    uint64_t count() const noexcept { return total_; }
+    uint64_t min() const noexcept { return total_ ? min_ : 0; }
+    uint64_t max() const noexcept { return max_; }
+    double mean() const noexcept { return total_ ? sum_ / total_ : 0; }
+
+    /**
+     * @brief Value at a percentile
+     * @param percentile 0..100
+     * @return Highest value equivalent to the bucket containing the percentile (clamped to max())
+     */
+    uint64_t percentile(double percentile) const noexcept {
+        if (total_ == 0) {
+            return 0;
+        }
+        auto target = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(total_)));
+        target = std::clamp<uint64_t>(target, 1, total_);
+        uint64_t seen = 0;
+        for (size_t i = 0; i < counts_.size(); ++i) {
+            seen += counts_[i];
+            if (seen >= target) {
+                return std::min(highest_equivalent(i), max_);
+            }
+        }
+        return max_;
+    }
+
+    /**
+     * @brief Print the percentile distribution in HdrHistogram's text layout
+     *
+     * @param os Output stream
+     * @param scale Divisor applied to values (e.g. ticks per ns)
+     * @param ticks_per_half Reporting steps per halving of the remaining tail
+     */
+    void print_spectrum(std::ostream& os, double scale = 1.0, uint32_t ticks_per_half = 5) const {
+        os << std::setw(12) << "Value" << std::setw(15) << "Percentile" << std::setw(12) << "TotalCount"
+           << std::setw(18) << "1/(1-Percentile)" << "\n";
+        if (total_ == 0) {
+            return;
+        }
+        double pct = 0;
+        uint64_t last_below = 0;
+        while (true) {
+            uint64_t value = percentile(pct);
+            uint64_t below = count_at_or_below(value);
+            double p = static_cast<double>(below) / total_;
+            if (below != last_below) {
+                last_below = below;
+                os << std::fixed << std::setprecision(2) << std::setw(12) << value / scale
+                   << std::setprecision(6) << std::setw(15) << p
+                   << std::setw(12) << below;
+                if (p < 1.0) {
+                    os << std::setprecision(2) << std::setw(18) << 1.0 / (1.0 - p);
+                }
+                os << "\n";
+            }
+            if (below >= total_) {
+                break;
+            }
+            // Halve the remaining distance to 100% every ticks_per_half steps
+            double remaining = 100.0 - pct;
+            double half_steps = std::pow(2.0, std::floor(std::log2(100.0 / remaining)) + 1);
+            pct += 100.0 / (half_steps * ticks_per_half);
+            if (pct >= 100.0 || 100.0 - pct < 100.0 / static_cast<double>(total_)) {
+                pct = 100.0;
+            }
+        }
+        os << std::defaultfloat;
+        os << "#[Mean = " << mean() / scale << ", Max = " << max_ / scale << ", Total count = " << total_ << "]\n";
+    }
+
+private:
+    std::vector<uint64_t> counts_;
+    uint64_t total_ = 0;
+    uint64_t min_ = std::numeric_limits<uint64_t>::max();
+    uint64_t max_ = 0;
+    double sum_ = 0;
+
+    static size_t index_of(uint64_t value) noexcept {
+        if (value < SUB_BUCKETS) {
+            return static_cast<size_t>(value);
+        }
+        uint32_t bucket = static_cast<uint32_t>(std::bit_width(value)) - SUB_BUCKET_BITS;   // >= 1
+        auto sub = static_cast<size_t>((value >> (bucket - 1)) - SUB_BUCKETS);              // 0..SUB_BUCKETS-1
+        return bucket * SUB_BUCKETS + sub;
+    }
+
+    static uint64_t lowest_equivalent(size_t index) noexcept {
+        uint64_t bucket = index / SUB_BUCKETS;
+        uint64_t sub = index % SUB_BUCKETS;
+        if (bucket == 0) {
+            return sub;
+        }
+        return (SUB_BUCKETS + sub) << (bucket - 1);
+    }
+
+    static uint64_t highest_equivalent(size_t index) noexcept {
+        uint64_t bucket = index / SUB_BUCKETS;
+        if (bucket == 0) {
+            return index;
+        }
+        return lowest_equivalent(index) + (uint64_t(1) << (bucket - 1)) - 1;
+    }
+
+    uint64_t count_at_or_below(uint64_t value) const noexcept {
+        uint64_t seen = 0;
+        size_t last = index_of(value);
+        for (size_t i = 0; i <= last; ++i) {
+            seen += counts_[i];
+        }
+        return seen;
+    }
+};
+
+}   // end namespace slick::bench
@@ -0,0 +1,162 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#include "bench.h"
+#include "histogram.h"
+#include "tsc.h"
+
+/**
+ * @file latency_bench.cpp
+ * @brief Tail latency of allocate() and free() at a fixed offered rate
+ *
+ * @details
+ * Each thread issues allocate()+free() pairs on a fixed schedule
+ * (--rate operations per second per thread). Every call is timed with fenced
+ * rdtsc/rdtscp and recorded into HDR-style histograms:
+ * - allocate, free: service time of each call, corrected for coordinated
+ *   omission with the expected interval between requests
+ * - response: completion time of the pair measured from its scheduled start,
+ *   so a stall also delays every request queued behind it
+ *
+ * Two pool states are measured:
+ * - steady: the pool is mostly free
+ * - near_exhaustion: all but --headroom objects per thread are held before the
+ *   run, so allocations walk the last free slots and occasionally fall back to heap
+ *
+ * Options:
+ *   --threads=1,2,4      Thread counts
+ *   --pool-size=4096     Pool capacity
+ *   --payload=64         Object size in bytes
+ *   --rate=1000000       Offered rate per thread (ops/s, 0 = back to back)
+ *   --ops=200000         Measured operations per thread
+ *   --warmup=20000       Warm-up operations per thread
+ *   --headroom=2         Free objects per thread left in near_exhaustion
+ *   --states=steady,near_exhaustion
+ *   --spectrum           Print the full percentile distribution of every histogram
+ */
+namespace {
+
+using namespace slick::bench;
+
+struct ThreadHistograms {
+    LatencyHistogram allocate;
+    LatencyHistogram free;
+    LatencyHistogram response;
+};
+
+template<size_t N>
+void run_latency_config(const Options& opts, Reporter& reporter, uint32_t threads, const std::string& state) {
+    using T = Payload<N>;
+    const uint32_t pool_size = static_cast<uint32_t>(opts.get_uint("pool-size", 4096));
+    const uint64_t rate = opts.get_uint("rate", 1000000);
+    const uint64_t ops = opts.get_uint("ops", 200000);
+    const uint64_t warmup = opts.get_uint("warmup", 20000);
+    const uint64_t headroom = opts.get_uint("headroom", 2);
+    const ThreadPlan plan = ThreadPlan::from(opts);
+    const uint64_t interval = rate ? Tsc::from_ns(1000000000ull / rate) : 0;
+
+    slick::ObjectPool<T> pool(pool_size);
+    std::vector<T*> held;
+    if (state == "near_exhaustion") {
+        uint64_t keep_free = std::min<uint64_t>(pool_size, headroom * threads);
+        for (uint64_t i = 0; i < pool_size - keep_free; ++i) {
+            held.push_back(pool.allocate());
+        }
+    } else if (state != "steady") {
+        throw std::runtime_error("unknown state " + state);
+    }
+
+    std::vector<ThreadHistograms> histograms(threads);
+    run_threads(threads, plan, [&](uint32_t t) {
+        auto& h = histograms[t];
+        for (uint64_t i = 0; i < warmup; ++i) {
+            pool.free(pool.allocate());
+        }
+        uint64_t scheduled = Tsc::start();
+        for (uint64_t i = 0; i < ops; ++i) {
+            if (interval) {
+                scheduled += interval;
+                while (Tsc::start() < scheduled) {
+                }
+            }
+            uint64_t s = Tsc::start();
+            T* obj = pool.allocate();
+            uint64_t m = Tsc::stop();
+            obj->id = i;
+            uint64_t m2 = Tsc::start();
+            pool.free(obj);
+            uint64_t e = Tsc::stop();
+            h.allocate.record_corrected(m - s, interval);
+            h.free.record_corrected(e - m2, interval);
+            h.response.record(e - (interval ? std::min(scheduled, s) : s));
+        }
+    });
+    for (T* obj : held) {
+        pool.free(obj);
+    }
+
+    ThreadHistograms total;
+    for (auto& h : histograms) {
+        total.allocate.merge(h.allocate);
+        total.free.merge(h.free);
+        total.response.merge(h.response);
+    }
+
+    const double ticks_per_ns = 1.0 / Tsc::ns_per_tick();
+    auto report = [&](const char* metric, const LatencyHistogram& h) {
+        Record row;
+        row.add("suite", "latency")
+            .add("payload", N)
+            .add("pool_size", pool_size)
+            .add("threads", threads)
+            .add("state", state)
+            .add("rate", rate)
+            .add("metric", metric)
+            .add("count", h.count())
+            .add("mean_ns", h.mean() / ticks_per_ns);
+        for (double p : { 50.0, 90.0, 99.0, 99.9, 99.99, 99.999 }) {
+            std::ostringstream name;
+            name << "p" << p << "_ns";
+            row.add(name.str(), static_cast<double>(Tsc::to_ns(h.percentile(p))));
+        }
+        row.add("max_ns", static_cast<double>(Tsc::to_ns(h.max())));
+        reporter.add(std::move(row));
+        if (opts.get_bool("spectrum", false)) {
+            std::cout << "## " << metric << " (ns), threads=" << threads << " state=" << state << "\n";
+            h.print_spectrum(std::cout, ticks_per_ns);
+        }
+    };
+    report("allocate", total.allocate);
+    report("free", total.free);
+    report("response", total.response);
+}
+
+void run_latency(const Options& opts, Reporter& reporter) {
+    auto thread_counts = opts.get_uint_list("threads", "1,2,4");
+    auto states = opts.get_list("states", "steady,near_exhaustion");
+    auto payload = opts.get_uint("payload", 64);
+    std::cout << "# time source: " << Tsc::source() << ", " << Tsc::ns_per_tick() << " ns/tick" << std::endl;
+
+    for (auto& state : states) {
+        for (auto threads : thread_counts) {
+            bool ok = dispatch_payload(payload, [&]<size_t N>() {
+                run_latency_config<N>(opts, reporter, static_cast<uint32_t>(threads), state);
+            });
+            if (!ok) {
+                throw std::runtime_error("unsupported payload size " + std::to_string(payload));
+            }
+        }
+    }
+}
+
+}   // namespace
+
+SLICK_BENCH_SUITE(latency, "per-call tail latency at a fixed offered rate (HDR histograms)", run_latency);
@@ -0,0 +1,170 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#include "bench.h"
+
+#include <slick/lifetime_pool.h>
+
+#include <cstring>
+
+/**
+ * @file lifetime_bench.cpp
+ * @brief Short-lived churn next to long-lived objects: one ring vs lifetime regions
+ *
+ * @details
+ * --resting long-lived objects are held (resting orders) while a stream of
+ * short-lived objects (quotes) is allocated, written, read back and freed,
+ * --burst at a time. Every --replace bursts one random resting object is
+ * replaced. Each repetition times the bursts:
+ * - mixed:    ObjectPool of 2 * resting objects serving both lifetimes;
+ *             short-lived objects cycle through every free object, scattered
+ *             between the resting ones
+ * - lifetime: LifetimePool with a short-lived region of bit_ceil(2 * burst)
+ *             objects and a long-lived region of 2 * resting objects
+ *
+ * Options:
+ *   --resting=65536,1048576   Long-lived objects held (powers of 2)
+ *   --payload=64,256          Object size in bytes (8..4096, powers of 2)
+ *   --burst=64                Short-lived objects outstanding at once
+ *   --replace=16              Bursts between resting object replacements (0 = never)
+ *   --ops=1000000             Short-lived objects per repetition
+ *   --repeat=5                Repetitions
+ */
+namespace {
+
+using namespace slick::bench;
+
+uint64_t next_random(uint64_t& state) noexcept {
+    state += 0x9E3779B97F4A7C15ull;
+    uint64_t z = state;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+double elapsed_ns(clock::time_point start) {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count());
+}
+
+/**
+ * @brief Time ops short-lived objects in bursts, replacing resting objects as they go
+ * @return Nanoseconds per short-lived object
+ */
+template<typename T, typename AllocateShort, typename AllocateLong, typename Free>
+double run_churn(std::vector<T*>& resting, std::vector<T*>& burst, uint64_t ops, uint64_t replace,
+    uint64_t& seed, AllocateShort allocate_short, AllocateLong allocate_long, Free free) {
+    auto start = clock::now();
+    uint64_t sum = 0;
+    for (uint64_t done = 0, bursts = 0; done < ops; done += burst.size(), ++bursts) {
+        for (size_t i = 0; i < burst.size(); ++i) {
+            T* obj = allocate_short();
+            std::memset(static_cast<void*>(obj), int(i), sizeof(T));
+            obj->id = done + i;
+            burst[i] = obj;
+        }
+        for (T* obj : burst) {
+            sum += obj->id + reinterpret_cast<const uint8_t*>(obj)[sizeof(T) - 1];
+            free(obj);
+        }
+        if (replace && bursts % replace == 0) {
+            auto& victim = resting[next_random(seed) % resting.size()];
+            free(victim);
+            victim = allocate_long();
+            victim->id = bursts;
+        }
+    }
+    do_not_optimize(sum);
+    return elapsed_ns(start) / static_cast<double>(ops);
+}
+
+template<size_t N>
+void run_config(const Options& opts, Reporter& reporter, uint32_t resting_count) {
+    using Object = Payload<N>;
+    const uint32_t repeat = static_cast<uint32_t>(std::max<uint64_t>(1, opts.get_uint("repeat", 5)));
+    const uint64_t ops = opts.get_uint("ops", 1000000);
+    const uint32_t burst_size = static_cast<uint32_t>(std::clamp<uint64_t>(opts.get_uint("burst", 64), 1, resting_count));
+    const uint64_t replace = opts.get_uint("replace", 16);
+    const uint32_t short_size = std::bit_ceil(2 * burst_size);
+
+    auto mixed = std::make_unique<slick::ObjectPool<Object>>(2 * resting_count);
+    auto split = std::make_unique<slick::LifetimePool<Object>>(short_size, 2 * resting_count);
+
+    // Interleave the two lifetimes while filling, as a live system does, so
+    // the resting objects of the mixed pool end up spread over its buffer
+    std::vector<Object*> mixed_resting;
+    std::vector<Object*> split_resting;
+    std::vector<Object*> burst(burst_size);
+    uint64_t seed = 42;
+    for (uint32_t i = 0; i < resting_count; ++i) {
+        std::vector<Object*> transient;
+        for (uint64_t k = next_random(seed) % 3; k > 0; --k) {
+            transient.push_back(mixed->allocate());
+        }
+        mixed_resting.push_back(mixed->allocate());
+        split_resting.push_back(split->allocate(slick::Lifetime::LONG_LIVED));
+        for (auto* obj : transient) {
+            mixed->free(obj);
+        }
+    }
+
+    std::vector<double> mixed_ns, split_ns;
+    seed = 7;
+    for (uint32_t rep = 0; rep < repeat; ++rep) {
+        mixed_ns.push_back(run_churn(mixed_resting, burst, ops, replace, seed,
+            [&] { return mixed->allocate(); }, [&] { return mixed->allocate(); },
+            [&](Object* obj) { mixed->free(obj); }));
+        split_ns.push_back(run_churn(split_resting, burst, ops, replace, seed,
+            [&] { return split->allocate(slick::Lifetime::SHORT_LIVED); },
+            [&] { return split->allocate(slick::Lifetime::LONG_LIVED); },
+            [&](Object* obj) { split->free(obj); }));
+    }
+    for (auto* obj : mixed_resting) {
+        mixed->free(obj);
+    }
+    for (auto* obj : split_resting) {
+        split->free(obj);
+    }
+
+    auto mixed_summary = summarize(mixed_ns);
+    auto split_summary = summarize(split_ns);
+    Record row;
+    row.add("suite", "lifetime")
+        .add("resting", resting_count)
+        .add("payload", N)
+        .add("burst", burst_size)
+        .add("short_region", short_size)
+        .add("replace", replace)
+        .add("repeat", repeat)
+        .add("mixed_ns_per_object", mixed_summary)
+        .add("lifetime_ns_per_object", split_summary)
+        .add("speedup", split_summary.median > 0 ? mixed_summary.median / split_summary.median : 0.0);
+    reporter.add(std::move(row));
+}
+
+void run_lifetime(const Options& opts, Reporter& reporter) {
+    for (auto payload : opts.get_uint_list("payload", "64,256")) {
+        for (auto resting : opts.get_uint_list("resting", "65536,1048576")) {
+            if (!resting || (resting & (resting - 1))) {
+                throw std::runtime_error("resting must be a power of 2");
+            }
+            bool known = dispatch_payload(payload, [&]<size_t N>() {
+                run_config<N>(opts, reporter, static_cast<uint32_t>(resting));
+            });
+            if (!known) {
+                throw std::runtime_error("unsupported payload size " + std::to_string(payload));
+            }
+        }
+    }
+}
+
+}   // namespace
+
+SLICK_BENCH_SUITE(lifetime, "short-lived churn beside long-lived objects, one ring vs LifetimePool regions", run_lifetime);
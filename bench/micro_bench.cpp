@@ -0,0 +1,197 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#include "bench.h"
+#include "perf_counters.h"
+
+/**
+ * @file micro_bench.cpp
+ * @brief Parameterized allocate/free microbenchmarks
+ *
+ * @details
+ * Sweeps payload size x pool size x thread count x operation mix. Each
+ * configuration is warmed up, then measured --repeat times on a fresh pool.
+ * One operation is one allocate() plus one free().
+ *
+ * Options:
+ *   --sizes=8,64,256,1024,4096   Payload sizes in bytes (8..4096, powers of 2)
+ *   --pool-sizes=1024,65536      Pool capacities
+ *   --threads=1,2,4              Thread counts
+ *   --mixes=alloc_free,batch,random
+ *   --ops=200000                 Operations per thread per repetition
+ *   --warmup=20000               Warm-up operations per thread
+ *   --repeat=5                   Repetitions
+ *   --batch=32                   Objects held by the batch mix
+ *   --perf                       Add hardware counters per operation (Linux perf_event_open)
+ */
+namespace {
+
+using namespace slick::bench;
+
+enum class Mix { alloc_free, batch, random };
+
+Mix parse_mix(const std::string& name) {
+    if (name == "alloc_free") return Mix::alloc_free;
+    if (name == "batch") return Mix::batch;
+    if (name == "random") return Mix::random;
+    throw std::runtime_error("unknown mix " + name);
+}
+
+/// xorshift64, cheap enough not to dominate the measured loop
+struct Rng {
+    uint64_t state;
+    explicit Rng(uint64_t seed) : state(seed * 0x9E3779B97F4A7C15ull + 1) {}
+    uint64_t operator()() noexcept {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+/**
+ * @brief Run `ops` operations of a mix on one thread
+ */
+template<typename T>
+void run_mix(slick::ObjectPool<T>& pool, Mix mix, uint64_t ops, uint32_t batch, uint64_t seed, std::vector<T*>& held) {
+    switch (mix) {
+    case Mix::alloc_free:
+        for (uint64_t i = 0; i < ops; ++i) {
+            T* obj = pool.allocate();
+            obj->id = i;
+            do_not_optimize(obj);
+            pool.free(obj);
+        }
+        break;
+    case Mix::batch:
+        for (uint64_t i = 0; i < ops; i += batch) {
+            for (uint32_t b = 0; b < batch; ++b) {
+                T* obj = pool.allocate();
+                obj->id = i + b;
+                held.push_back(obj);
+            }
+            for (T* obj : held) {
+                pool.free(obj);
+            }
+            held.clear();
+        }
+        break;
+    case Mix::random: {
+        // Random allocate/free with up to `batch` live objects: exercises out-of-order frees
+        Rng rng(seed);
+        uint64_t allocs = 0;
+        while (allocs < ops) {
+            auto r = rng();
+            if (held.size() < batch && ((r & 1) || held.empty())) {
+                T* obj = pool.allocate();
+                obj->id = allocs++;
+                held.push_back(obj);
+            } else {
+                auto idx = (r >> 1) % held.size();
+                pool.free(held[idx]);
+                held[idx] = held.back();
+                held.pop_back();
+            }
+        }
+        for (T* obj : held) {
+            pool.free(obj);
+        }
+        held.clear();
+        break;
+    }
+    }
+}
+
+template<size_t N>
+void run_config(const Options& opts, Reporter& reporter, uint32_t pool_size, uint32_t threads, const std::string& mix_name) {
+    using T = Payload<N>;
+    const Mix mix = parse_mix(mix_name);
+    const uint64_t ops = opts.get_uint("ops", 200000);
+    const uint64_t warmup = opts.get_uint("warmup", 20000);
+    const uint32_t repeat = static_cast<uint32_t>(std::max<uint64_t>(1, opts.get_uint("repeat", 5)));
+    const uint32_t batch = static_cast<uint32_t>(std::max<uint64_t>(1, opts.get_uint("batch", 32)));
+    const ThreadPlan plan = ThreadPlan::from(opts);
+
+    std::vector<double> ns_per_op;
+    std::vector<double> mops;
+    Record record;
+    PerfAggregate perf(opts.get_bool("perf", false));
+    for (uint32_t rep = 0; rep < repeat; ++rep) {
+        slick::ObjectPool<T> pool(pool_size);
+        std::vector<std::chrono::nanoseconds> busy(threads);
+        StartBarrier measured(threads);
+        run_threads(threads, plan, [&](uint32_t t) {
+            std::vector<T*> held;
+            held.reserve(batch);
+            run_mix(pool, mix, warmup, batch, t + 1, held);
+            measured.arrive_and_wait();
+            PerfAggregate::Region region(perf);
+            auto start = clock::now();
+            run_mix(pool, mix, ops, batch, t + 1, held);
+            busy[t] = clock::now() - start;
+        });
+
+        // ns/op: average time a thread spends per operation; Mops: aggregate throughput
+        double total_busy = 0;
+        double slowest = 0;
+        for (auto& b : busy) {
+            total_busy += static_cast<double>(b.count());
+            slowest = std::max(slowest, static_cast<double>(b.count()));
+        }
+        ns_per_op.push_back(total_busy / (static_cast<double>(ops) * threads));
+        mops.push_back(static_cast<double>(ops) * threads / slowest * 1e3);
+        if (rep + 1 == repeat) {
+            add_cas_profile(record, pool);
+        }
+    }
+
+    Record row;
+    row.add("suite", "micro")
+        .add("payload", N)
+        .add("pool_size", pool_size)
+        .add("threads", threads)
+        .add("mix", mix_name)
+        .add("ops", ops)
+        .add("repeat", repeat)
+        .add("ns_per_op", summarize(ns_per_op))
+        .add("mops", summarize(mops));
+    perf.add_to(row, static_cast<double>(ops) * threads * repeat);
+    for (auto& [key, value] : record.fields()) {
+        row.add(key, value);
+    }
+    reporter.add(std::move(row));
+}
+
+void run_micro(const Options& opts, Reporter& reporter) {
+    auto sizes = opts.get_uint_list("sizes", "8,64,256,1024,4096");
+    auto pool_sizes = opts.get_uint_list("pool-sizes", "1024,65536");
+    auto thread_counts = opts.get_uint_list("threads", "1,2,4");
+    auto mixes = opts.get_list("mixes", "alloc_free,batch,random");
+
+    for (auto size : sizes) {
+        for (auto pool_size : pool_sizes) {
+            for (auto threads : thread_counts) {
+                for (auto& mix : mixes) {
+                    bool ok = dispatch_payload(size, [&]<size_t N>() {
+                        run_config<N>(opts, reporter, static_cast<uint32_t>(pool_size), static_cast<uint32_t>(threads), mix);
+                    });
+                    if (!ok) {
+                        throw std::runtime_error("unsupported payload size " + std::to_string(size));
+                    }
+                }
+            }
+        }
+    }
+}
+
+}   // namespace
+
+SLICK_BENCH_SUITE(micro, "allocate/free sweep over payload, pool size, threads and mix", run_micro);
@@ -0,0 +1,464 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#include "bench.h"
+#include "histogram.h"
+#include "perf_counters.h"
+#include "tsc.h"
+
+#include <optional>
+#include <queue>
+#include <random>
+#include <slick/pool_id_index.h>
+
+#include <unordered_map>
+
+/**
+ * @file orderbook_bench.cpp
+ * @brief Limit order book driven by a synthetic message stream
+ *
+ * @details
+ * Every order and every price level node comes from a slick::ObjectPool. Each
+ * thread runs its own book on its own pre-generated stream, all threads sharing
+ * the two pools. Orders are found by exchange id through an unordered_map
+ * reserved up front, so lookups do not allocate during the run, or through a
+ * slick::PoolIdIndex over the order pool (--index=pool).
+ *
+ * The stream has a configurable add/cancel/modify/execute mix. Each added order
+ * draws a lifetime from a two-class exponential mixture (short-lived quotes and
+ * long resting orders); cancels and executes remove the order whose lifetime
+ * expires first. Modifies change quantity in place or move the order to a new
+ * price (losing queue priority).
+ *
+ * Reported: message throughput, per-message latency percentiles per message
+ * type, and pool occupancy sampled over the run.
+ *
+ * Options:
+ *   --messages=1000000       Messages per thread
+ *   --threads=1              Books (one per thread) sharing the pools
+ *   --mix=40,30,20,10        add,cancel,modify,execute percentages (adds = removals keeps the book steady)
+ *   --short-frac=0.9         Fraction of short-lived orders
+ *   --short-life=50          Mean lifetime of short-lived orders (messages)
+ *   --long-life=50000        Mean lifetime of long-lived orders (messages)
+ *   --order-pool=65536       Order pool capacity
+ *   --level-pool=4096        Level pool capacity
+ *   --samples=20             Occupancy samples per run
+ *   --index=map              Order lookup: map (std::unordered_map) or pool (slick::PoolIdIndex)
+ *   --perf                   Add hardware counters per message
+ *   --trace=<file>           Record the order pool's allocate/free events (replay with slick_object_pool_replay)
+ */
+namespace {
+
+using namespace slick::bench;
+
+constexpr int64_t PRICE_LEVELS = 2048;      // ticks covered by the book
+constexpr int64_t MID_PRICE = PRICE_LEVELS / 2;
+
+enum class Side : uint8_t { buy, sell };
+enum class MsgType : uint8_t { add, cancel, modify, execute };
+constexpr const char* MSG_NAMES[] = { "add", "cancel", "modify", "execute" };
+
+struct Level;
+
+struct Order {
+    uint64_t id = 0;
+    int64_t price = 0;
+    uint32_t qty = 0;
+    Side side = Side::buy;
+    Order* prev = nullptr;
+    Order* next = nullptr;
+    Level* level = nullptr;
+    char client_tag[16] = {};
+};
+
+struct Level {
+    int64_t price = 0;
+    uint64_t total_qty = 0;
+    uint32_t count = 0;
+    Order* head = nullptr;
+    Order* tail = nullptr;
+};
+
+struct Message {
+    MsgType type;
+    Side side;
+    uint32_t qty;
+    int64_t price;
+    uint64_t id;
+};
+
+/**
+ * @brief Single-writer price-time priority book
+ */
+class Book {
+    slick::ObjectPool<Order>& orders_;
+    slick::ObjectPool<Level>& levels_;
+    std::vector<Level*> bids_;
+    std::vector<Level*> asks_;
+    std::unordered_map<uint64_t, Order*> by_id_;
+    std::unique_ptr<slick::PoolIdIndex<Order>> index_;  // replaces by_id_ with --index=pool
+
+public:
+    std::atomic<int64_t> live_orders{ 0 };
+    std::atomic<int64_t> live_levels{ 0 };
+
+    Book(slick::ObjectPool<Order>& orders, slick::ObjectPool<Level>& levels, size_t expected_orders, bool pool_index)
+        : orders_(orders), levels_(levels), bids_(PRICE_LEVELS, nullptr), asks_(PRICE_LEVELS, nullptr)
+    {
+        if (pool_index) {
+            index_ = std::make_unique<slick::PoolIdIndex<Order>>(orders, static_cast<uint32_t>(expected_orders));
+        } else {
+            by_id_.reserve(expected_orders);
+        }
+    }
+
+    ~Book() {
+        for (auto* side : { &bids_, &asks_ }) {
+            for (Level* level : *side) {
+                if (level) {
+                    for (Order* order = level->head; order;) {
+                        Order* next = order->next;
+                        orders_.free(order);
+                        order = next;
+                    }
+                    levels_.free(level);
+                }
+            }
+        }
+    }
+
+    void apply(const Message& msg) {
+        switch (msg.type) {
+        case MsgType::add: {
+            auto init = [&msg](Order& order) {
+                order.id = msg.id;
+                order.qty = msg.qty;
+                order.side = msg.side;
+            };
+            Order* order;
+            if (index_) {
+                // Indexed orders must come from the pool; drop the add when it is exhausted
+                order = index_->allocate(msg.id, init);
+                if (!order) {
+                    return;
+                }
+            } else {
+                order = orders_.allocate();
+                init(*order);
+                by_id_.emplace(msg.id, order);
+            }
+            insert(order, msg.price);
+            live_orders.store(live_orders.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            break;
+        }
+        case MsgType::cancel:
+        case MsgType::execute: {
+            Order* order = find(msg.id);
+            if (!order) {
+                return;
+            }
+            if (msg.type == MsgType::execute && msg.qty < order->qty) {
+                order->qty -= msg.qty;
+                order->level->total_qty -= msg.qty;
+                return;
+            }
+            if (index_) {
+                index_->erase(msg.id);
+            } else {
+                by_id_.erase(msg.id);
+            }
+            unlink(order);
+            orders_.free(order);
+            live_orders.store(live_orders.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+            break;
+        }
+        case MsgType::modify: {
+            Order* order = find(msg.id);
+            if (!order) {
+                return;
+            }
+            if (msg.price == order->price) {
+                order->level->total_qty += msg.qty;
+                order->level->total_qty -= order->qty;
+                order->qty = msg.qty;
+            } else {
+                unlink(order);
+                order->qty = msg.qty;
+                insert(order, msg.price);
+            }
+            break;
+        }
+        }
+    }
+
+private:
+    Order* find(uint64_t id) const {
+        if (index_) {
+            return index_->find(id);
+        }
+        auto it = by_id_.find(id);
+        return it == by_id_.end() ? nullptr : it->second;
+    }
+
+    std::vector<Level*>& side_of(Side side) noexcept {
+        return side == Side::buy ? bids_ : asks_;
+    }
+
+    void insert(Order* order, int64_t price) {
+        auto& levels = side_of(order->side);
+        Level*& level = levels[price];
+        if (!level) {
+            level = levels_.allocate();
+            level->price = price;
+            level->total_qty = 0;
+            level->count = 0;
+            level->head = level->tail = nullptr;
+            live_levels.store(live_levels.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+        order->price = price;
+        order->level = level;
+        order->next = nullptr;
+        order->prev = level->tail;
+        if (level->tail) {
+            level->tail->next = order;
+        } else {
+            level->head = order;
+        }
+        level->tail = order;
+        level->total_qty += order->qty;
+        ++level->count;
+    }
+
+    void unlink(Order* order) {
+        Level* level = order->level;
+        if (order->prev) {
+            order->prev->next = order->next;
+        } else {
+            level->head = order->next;
+        }
+        if (order->next) {
+            order->next->prev = order->prev;
+        } else {
+            level->tail = order->prev;
+        }
+        level->total_qty -= order->qty;
+        if (--level->count == 0) {
+            side_of(order->side)[level->price] = nullptr;
+            levels_.free(level);
+            live_levels.store(live_levels.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+        }
+        order->level = nullptr;
+    }
+};
+
+/**
+ * @brief Generate a message stream with the configured mix and lifetime distribution
+ */
+std::vector<Message> generate_stream(const Options& opts, uint64_t messages, uint64_t seed) {
+    auto mix = opts.get_uint_list("mix", "40,30,20,10");
+    if (mix.size() != 4) {
+        throw std::runtime_error("--mix needs 4 percentages: add,cancel,modify,execute");
+    }
+    const double short_frac = opts.get_double("short-frac", 0.9);
+    std::exponential_distribution<double> short_life(1.0 / opts.get_double("short-life", 50));
+    std::exponential_distribution<double> long_life(1.0 / opts.get_double("long-life", 50000));
+    std::discrete_distribution<int> type_dist(mix.begin(), mix.end());
+    std::uniform_real_distribution<double> unit(0, 1);
+    std::normal_distribution<double> price_offset(0, 20);
+    std::uniform_int_distribution<uint32_t> qty_dist(1, 1000);
+    std::mt19937_64 rng(seed);
+
+    struct Live {
+        uint64_t expires;
+        uint64_t id;
+        int64_t price;
+        Side side;
+        uint32_t qty;
+        bool operator>(const Live& o) const noexcept { return expires > o.expires; }
+    };
+    std::priority_queue<Live, std::vector<Live>, std::greater<>> live;   // earliest expiry first
+    std::vector<Message> stream;
+    stream.reserve(messages);
+    uint64_t next_id = seed << 40;
+
+    for (uint64_t i = 0; i < messages; ++i) {
+        auto type = static_cast<MsgType>(type_dist(rng));
+        if (live.empty()) {
+            type = MsgType::add;
+        }
+        switch (type) {
+        case MsgType::add: {
+            Side side = (rng() & 1) ? Side::buy : Side::sell;
+            double offset = std::abs(price_offset(rng));
+            int64_t price = side == Side::buy ? MID_PRICE - 1 - static_cast<int64_t>(offset) : MID_PRICE + static_cast<int64_t>(offset);
+            price = std::clamp<int64_t>(price, 0, PRICE_LEVELS - 1);
+            double life = unit(rng) < short_frac ? short_life(rng) : long_life(rng);
+            Live order{ i + 1 + static_cast<uint64_t>(life), ++next_id, price, side, qty_dist(rng) };
+            live.push(order);
+            stream.push_back({ MsgType::add, side, order.qty, price, order.id });
+            break;
+        }
+        case MsgType::cancel:
+        case MsgType::execute: {
+            Live order = live.top();
+            live.pop();
+            // Executes fill the whole order; partial fills are modelled by modify
+            stream.push_back({ type, order.side, order.qty, order.price, order.id });
+            break;
+        }
+        case MsgType::modify: {
+            Live order = live.top();
+            live.pop();
+            uint32_t qty = qty_dist(rng);
+            int64_t price = order.price;
+            if (rng() & 1) {
+                price = std::clamp<int64_t>(price + (order.side == Side::buy ? -1 : 1), 0, PRICE_LEVELS - 1);
+            }
+            order.qty = qty;
+            order.price = price;
+            live.push(order);
+            stream.push_back({ MsgType::modify, order.side, qty, price, order.id });
+            break;
+        }
+        }
+    }
+    return stream;
+}
+
+void run_orderbook(const Options& opts, Reporter& reporter) {
+    const uint64_t messages = opts.get_uint("messages", 1000000);
+    const uint32_t threads = static_cast<uint32_t>(opts.get_uint("threads", 1));
+    const uint32_t order_pool = static_cast<uint32_t>(opts.get_uint("order-pool", 65536));
+    const uint32_t level_pool = static_cast<uint32_t>(opts.get_uint("level-pool", 4096));
+    const uint64_t samples = std::max<uint64_t>(1, opts.get_uint("samples", 20));
+    const bool pool_index = opts.get("index", "map") == "pool";
+    const ThreadPlan plan = ThreadPlan::from(opts);
+
+    std::vector<std::vector<Message>> streams;
+    for (uint32_t t = 0; t < threads; ++t) {
+        streams.push_back(generate_stream(opts, messages, t + 1));
+    }
+
+    slick::ObjectPool<Order> orders(order_pool);
+    slick::ObjectPool<Level> levels(level_pool);
+    std::vector<std::unique_ptr<Book>> books;
+    for (uint32_t t = 0; t < threads; ++t) {
+        books.push_back(std::make_unique<Book>(orders, levels, order_pool, pool_index));
+    }
+
+    struct Sample {
+        uint64_t message;
+        int64_t orders;
+        int64_t levels;
+    };
+    std::vector<Sample> occupancy;
+    std::vector<std::array<LatencyHistogram, 4>> histograms(threads);
+    std::vector<std::chrono::nanoseconds> busy(threads);
+    const uint64_t sample_every = std::max<uint64_t>(1, messages / samples);
+    PerfAggregate perf(opts.get_bool("perf", false));
+    std::optional<slick::AllocationTrace> trace;
+    if (opts.has("trace")) {
+        trace.emplace(opts.get("trace", ""));
+        orders.trace(&*trace);
+    }
+
+    run_threads(threads, plan, [&](uint32_t t) {
+        auto& book = *books[t];
+        auto& hist = histograms[t];
+        PerfAggregate::Region region(perf);
+        auto start = clock::now();
+        for (uint64_t i = 0; i < messages; ++i) {
+            const Message& msg = streams[t][i];
+            uint64_t s = Tsc::start();
+            book.apply(msg);
+            hist[static_cast<size_t>(msg.type)].record(Tsc::stop() - s);
+            if (t == 0 && (i + 1) % sample_every == 0) {
+                // Thread 0 samples occupancy of all books
+                Sample sample{ i + 1, 0, 0 };
+                for (auto& b : books) {
+                    sample.orders += b->live_orders.load(std::memory_order_relaxed);
+                    sample.levels += b->live_levels.load(std::memory_order_relaxed);
+                }
+                occupancy.push_back(sample);
+            }
+        }
+        busy[t] = clock::now() - start;
+    });
+    if (trace) {
+        orders.trace(nullptr);
+        trace->close();
+        std::cout << "# orderbook: " << trace->events() << " order pool events written to " << opts.get("trace", "") << '\n';
+    }
+
+    double slowest = 0;
+    for (auto& b : busy) {
+        slowest = std::max(slowest, static_cast<double>(b.count()));
+    }
+    LatencyHistogram all;
+    std::array<LatencyHistogram, 4> by_type;
+    for (auto& h : histograms) {
+        for (size_t i = 0; i < 4; ++i) {
+            by_type[i].merge(h[i]);
+            all.merge(h[i]);
+        }
+    }
+    int64_t peak_orders = 0, peak_levels = 0;
+    for (auto& s : occupancy) {
+        peak_orders = std::max(peak_orders, s.orders);
+        peak_levels = std::max(peak_levels, s.levels);
+    }
+
+    auto ns = [](uint64_t ticks) { return static_cast<double>(Tsc::to_ns(ticks)); };
+    auto add_percentiles = [&](Record& row, const LatencyHistogram& h) {
+        row.add("count", h.count())
+            .add("mean_ns", h.mean() * Tsc::ns_per_tick())
+            .add("p50_ns", ns(h.percentile(50)))
+            .add("p99_ns", ns(h.percentile(99)))
+            .add("p99.9_ns", ns(h.percentile(99.9)))
+            .add("p99.99_ns", ns(h.percentile(99.99)))
+            .add("max_ns", ns(h.max()));
+    };
+
+    Record summary;
+    summary.add("suite", "orderbook")
+        .add("threads", threads)
+        .add("order_pool", order_pool)
+        .add("level_pool", level_pool)
+        .add("index", pool_index ? "pool" : "map")
+        .add("type", "all")
+        .add("msgs_per_sec", static_cast<double>(messages) * threads / slowest * 1e9)
+        .add("peak_orders", peak_orders)
+        .add("peak_levels", peak_levels);
+    add_percentiles(summary, all);
+    perf.add_to(summary, static_cast<double>(messages) * threads);
+    add_cas_profile(summary, orders);
+    reporter.add(std::move(summary));
+    for (size_t i = 0; i < 4; ++i) {
+        Record row;
+        row.add("suite", "orderbook").add("threads", threads).add("type", MSG_NAMES[i]);
+        add_percentiles(row, by_type[i]);
+        reporter.add(std::move(row));
+    }
+    for (auto& s : occupancy) {
+        Record row;
+        row.add("suite", "orderbook_occupancy")
+            .add("message", s.message)
+            .add("live_orders", s.orders)
+            .add("order_occupancy", static_cast<double>(s.orders) / order_pool)
+            .add("live_levels", s.levels)
+            .add("level_occupancy", static_cast<double>(s.levels) / level_pool);
+        reporter.add(std::move(row));
+    }
+}
+
+}   // namespace
+
+SLICK_BENCH_SUITE(orderbook, "limit order book workload with pooled orders and levels", run_orderbook);
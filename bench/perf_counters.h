@@ -0,0 +1,272 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace slick::bench {
+
+/**
+ * @brief Hardware performance counters of the calling thread (Linux perf_event_open)
+ *
+ * @details
+ * Opens one counter per event for the calling thread only (user space, not
+ * kernel). Events are opened individually, so a missing event (e.g. dTLB misses
+ * on some virtual machines) does not disable the others. Values are scaled by
+ * time_enabled / time_running when the kernel multiplexes counters.
+ *
+ * When perf_event_open is not permitted (containers, perf_event_paranoid > 2,
+ * non-Linux platforms) every event reports as unavailable and error() explains why.
+ */
+class PerfCounters {
+public:
+    enum Event : uint32_t {
+        CYCLES = 0,
+        INSTRUCTIONS,
+        L1D_MISSES,
+        LLC_MISSES,
+        DTLB_MISSES,
+        BRANCH_MISSES,
+        EVENT_COUNT
+    };
+
+    static constexpr const char* event_name(size_t event) noexcept {
+        constexpr const char* names[] = { "cycles", "instructions", "l1d_misses", "llc_misses", "dtlb_misses", "branch_misses" };
+        return event < EVENT_COUNT ? names[event] : "unknown";
+    }
+
+    struct Sample {
+        std::array<bool, EVENT_COUNT> valid{};
+        std::array<double, EVENT_COUNT> value{};
+
+        Sample& operator+=(const Sample& other) noexcept {
+            for (size_t i = 0; i < EVENT_COUNT; ++i) {
+                valid[i] = valid[i] || other.valid[i];
+                value[i] += other.value[i];
+            }
+            return *this;
+        }
+
+        bool any() const noexcept {
+            for (bool v : valid) {
+                if (v) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    PerfCounters() {
+        fds_.fill(-1);
+#if defined(__linux__)
+        for (uint32_t i = 0; i < EVENT_COUNT; ++i) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            configure(static_cast<Event>(i), attr);
+            fds_[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            if (fds_[i] < 0 && error_.empty()) {
+                error_ = std::string(event_name(i)) + ": " + std::strerror(errno);
+                if (errno == EACCES || errno == EPERM) {
+                    error_ += " (check /proc/sys/kernel/perf_event_paranoid or container seccomp profile)";
+                }
+            }
+        }
+#else
+        error_ = "perf_event_open is only available on Linux";
+#endif
+    }
+
+    ~PerfCounters() {
+#if defined(__linux__)
+        for (int fd : fds_) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /// True if at least one counter could be opened
+    bool available() const noexcept {
+        for (int fd : fds_) {
+            if (fd >= 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// First failure reason, empty if every counter opened
+    const std::string& error() const noexcept {
+        return error_;
+    }
+
+    void start() noexcept {
+#if defined(__linux__)
+        for (int fd : fds_) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    Sample stop() noexcept {
+        Sample sample;
+#if defined(__linux__)
+        for (int fd : fds_) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+        for (uint32_t i = 0; i < EVENT_COUNT; ++i) {
+            uint64_t data[3] = {};   // value, time_enabled, time_running
+            if (fds_[i] >= 0 && read(fds_[i], data, sizeof(data)) == static_cast<ssize_t>(sizeof(data)) && data[2] > 0) {
+                sample.valid[i] = true;
+                sample.value[i] = static_cast<double>(data[0]) * static_cast<double>(data[1]) / static_cast<double>(data[2]);
+            }
+        }
+#endif
+        return sample;
+    }
+
+private:
+    std::array<int, EVENT_COUNT> fds_;
+    std::string error_;
+
+#if defined(__linux__)
+    static void configure(Event event, perf_event_attr& attr) noexcept {
+        auto cache = [&](uint64_t id) {
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = id | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        };
+        switch (event) {
+        case CYCLES:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case INSTRUCTIONS:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case L1D_MISSES:
+            cache(PERF_COUNT_HW_CACHE_L1D);
+            break;
+        case LLC_MISSES:
+            cache(PERF_COUNT_HW_CACHE_LL);
+            break;
+        case DTLB_MISSES:
+            cache(PERF_COUNT_HW_CACHE_DTLB);
+            break;
+        case BRANCH_MISSES:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        default:
+            break;
+        }
+    }
+#endif
+};
+
+/**
+ * @brief Sums per-thread counter samples of one measured region
+ *
+ * @details
+ * Each worker constructs a Region around its measured loop; the sums are
+ * reported per operation. With --perf unset this does nothing.
+ */
+class PerfAggregate {
+    bool enabled_;
+    std::mutex mutex_;
+    PerfCounters::Sample total_;
+    std::string error_;
+
+public:
+    explicit PerfAggregate(bool enabled) : enabled_(enabled) {}
+
+    class Region {
+        PerfAggregate& owner_;
+        std::optional<PerfCounters> counters_;
+
+    public:
+        explicit Region(PerfAggregate& owner) : owner_(owner) {
+            if (owner_.enabled_) {
+                counters_.emplace();
+                counters_->start();
+            }
+        }
+
+        ~Region() {
+            if (counters_) {
+                auto sample = counters_->stop();
+                std::lock_guard lock(owner_.mutex_);
+                owner_.total_ += sample;
+                if (owner_.error_.empty()) {
+                    owner_.error_ = counters_->error();
+                }
+            }
+        }
+
+        Region(const Region&) = delete;
+        Region& operator=(const Region&) = delete;
+    };
+
+    /**
+     * @brief Add per-operation counter columns to a record
+     * @details Unavailable events are omitted; the first failure is printed once per process
+     */
+    template<typename Record>
+    void add_to(Record& record, double ops) {
+        if (!enabled_) {
+            return;
+        }
+        static std::once_flag warned;
+        if (!error_.empty()) {
+            std::call_once(warned, [&] { std::cerr << "# perf counters: " << error_ << std::endl; });
+        }
+        for (size_t i = 0; i < PerfCounters::EVENT_COUNT; ++i) {
+            if (total_.valid[i] && ops > 0) {
+                record.add(std::string(PerfCounters::event_name(i)) + "_per_op", total_.value[i] / ops);
+            }
+        }
+        if (total_.valid[PerfCounters::CYCLES] && total_.valid[PerfCounters::INSTRUCTIONS] && total_.value[PerfCounters::CYCLES] > 0) {
+            record.add("ipc", total_.value[PerfCounters::INSTRUCTIONS] / total_.value[PerfCounters::CYCLES]);
+        }
+    }
+};
+
+}   // end namespace slick::bench
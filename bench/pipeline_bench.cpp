@@ -0,0 +1,178 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#include "bench.h"
+#include "perf_counters.h"
+#include "queue.h"
+
+/**
+ * @file pipeline_bench.cpp
+ * @brief Cross-thread producer/consumer benchmark
+ *
+ * @details
+ * Producers allocate() messages and push them through a bounded MPMC queue;
+ * consumers pop them and free() them. Objects therefore leave the pool on one
+ * core and return on another, so reserve() and consume() run on different
+ * CPUs. Producers are pinned first, then consumers, on the CPU list.
+ *
+ * Reported per configuration:
+ * - throughput (messages/s)
+ * - allocate() and free() cost per call on their respective threads
+ * - message latency (allocate -> free) percentiles
+ *
+ * Options:
+ *   --producers=1,2          Producer counts
+ *   --consumers=1,2          Consumer counts
+ *   --messages=200000        Messages per producer
+ *   --pool-sizes=1024,65536  Pool capacities
+ *   --queue-size=4096        Queue capacity (power of 2)
+ *   --payload=64             Message size in bytes
+ *   --perf                   Add hardware counters per message, producer and consumer side
+ */
+namespace {
+
+using namespace slick::bench;
+
+template<size_t N>
+struct Message {
+    static_assert(N >= 2 * sizeof(uint64_t));
+    clock::time_point created;
+    uint64_t sequence = 0;
+    std::array<char, N - 2 * sizeof(uint64_t)> data{};
+};
+
+template<size_t N>
+void run_pipeline_config(const Options& opts, Reporter& reporter, uint32_t pool_size, uint32_t producers, uint32_t consumers) {
+    using T = Message<N>;
+    const uint64_t messages = opts.get_uint("messages", 200000);
+    const uint64_t queue_size = opts.get_uint("queue-size", 4096);
+    const ThreadPlan plan = ThreadPlan::from(opts);
+
+    slick::ObjectPool<T> pool(pool_size);
+    MpmcQueue<T*> queue(queue_size);
+    std::atomic<uint32_t> producers_done{ 0 };
+    std::vector<std::vector<double>> latencies(consumers);
+    std::vector<double> alloc_ns(producers), free_ns(consumers);
+    std::vector<uint64_t> consumed(consumers);
+    PerfAggregate producer_perf(opts.get_bool("perf", false));
+    PerfAggregate consumer_perf(opts.get_bool("perf", false));
+
+    auto wall = run_threads(producers + consumers, plan, [&](uint32_t t) {
+        if (t < producers) {
+            PerfAggregate::Region region(producer_perf);
+            std::chrono::nanoseconds in_alloc{ 0 };
+            for (uint64_t i = 0; i < messages; ++i) {
+                auto start = clock::now();
+                T* msg = pool.allocate();
+                auto end = clock::now();
+                in_alloc += end - start;
+                msg->created = end;
+                msg->sequence = i;
+                while (!queue.try_push(msg)) {
+                    std::this_thread::yield();
+                }
+            }
+            alloc_ns[t] = static_cast<double>(in_alloc.count());
+            producers_done.fetch_add(1, std::memory_order_release);
+        } else {
+            PerfAggregate::Region region(consumer_perf);
+            auto c = t - producers;
+            auto& lat = latencies[c];
+            lat.reserve(messages * producers / consumers + 1);
+            std::chrono::nanoseconds in_free{ 0 };
+            T* msg;
+            while (true) {
+                // Check completion before popping so no message pushed before the last producer finished is missed
+                bool done = producers_done.load(std::memory_order_acquire) == producers;
+                if (queue.try_pop(msg)) {
+                    auto start = clock::now();
+                    lat.push_back(static_cast<double>((start - msg->created).count()));
+                    pool.free(msg);
+                    in_free += clock::now() - start;
+                    ++consumed[c];
+                } else if (done) {
+                    break;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+            free_ns[c] = static_cast<double>(in_free.count());
+        }
+    });
+
+    std::vector<double> all;
+    uint64_t total = 0;
+    double total_free = 0;
+    for (uint32_t c = 0; c < consumers; ++c) {
+        all.insert(all.end(), latencies[c].begin(), latencies[c].end());
+        total += consumed[c];
+        total_free += free_ns[c];
+    }
+    double total_alloc = 0;
+    for (auto ns : alloc_ns) {
+        total_alloc += ns;
+    }
+    std::sort(all.begin(), all.end());
+
+    Record row;
+    row.add("suite", "pipeline")
+        .add("payload", N)
+        .add("pool_size", pool_size)
+        .add("producers", producers)
+        .add("consumers", consumers)
+        .add("messages", total)
+        .add("msgs_per_sec", total / (static_cast<double>(wall.count()) * 1e-9))
+        .add("alloc_ns", total_alloc / (static_cast<double>(messages) * producers))
+        .add("free_ns", total ? total_free / total : 0.0)
+        .add("latency_p50_ns", quantile_sorted(all, 0.50))
+        .add("latency_p90_ns", quantile_sorted(all, 0.90))
+        .add("latency_p99_ns", quantile_sorted(all, 0.99))
+        .add("latency_p999_ns", quantile_sorted(all, 0.999))
+        .add("latency_max_ns", all.empty() ? 0.0 : all.back());
+    add_cas_profile(row, pool);
+    Record producer_counters, consumer_counters;
+    producer_perf.add_to(producer_counters, static_cast<double>(total));
+    consumer_perf.add_to(consumer_counters, static_cast<double>(total));
+    for (auto& [key, value] : producer_counters.fields()) {
+        row.add("producer_" + key, value);
+    }
+    for (auto& [key, value] : consumer_counters.fields()) {
+        row.add("consumer_" + key, value);
+    }
+    reporter.add(std::move(row));
+}
+
+void run_pipeline(const Options& opts, Reporter& reporter) {
+    auto pool_sizes = opts.get_uint_list("pool-sizes", "1024,65536");
+    auto producer_counts = opts.get_uint_list("producers", "1,2");
+    auto consumer_counts = opts.get_uint_list("consumers", "1,2");
+    auto payload = opts.get_uint("payload", 64);
+
+    for (auto pool_size : pool_sizes) {
+        for (auto producers : producer_counts) {
+            for (auto consumers : consumer_counts) {
+                bool ok = payload >= 16 && dispatch_payload(payload, [&]<size_t N>() {
+                    if constexpr (N >= 16) {
+                        run_pipeline_config<N>(opts, reporter, static_cast<uint32_t>(pool_size),
+                            static_cast<uint32_t>(producers), static_cast<uint32_t>(consumers));
+                    }
+                });
+                if (!ok) {
+                    throw std::runtime_error("unsupported payload size " + std::to_string(payload));
+                }
+            }
+        }
+    }
+}
+
+}   // namespace
+
+SLICK_BENCH_SUITE(pipeline, "allocate on producer threads, free on consumer threads", run_pipeline);
@@ -0,0 +1,98 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+
+namespace slick::bench {
+
+/**
+ * @brief Bounded MPMC queue (Vyukov) used to hand objects between benchmark threads
+ *
+ * @details
+ * Kept independent of the pool's own ring so the pipeline benchmarks measure
+ * the pool, not a shared implementation.
+ *
+ * @tparam T Trivially copyable element type
+ */
+template<typename T>
+class MpmcQueue {
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    struct cell {
+        std::atomic<uint64_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<cell[]> cells_;
+    uint64_t mask_;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> enqueue_pos_{ 0 };
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> dequeue_pos_{ 0 };
+    char padding_[CACHE_LINE_SIZE - sizeof(std::atomic<uint64_t>)];
+
+public:
+    /// @param capacity Queue capacity (must be power of 2)
+    explicit MpmcQueue(uint64_t capacity)
+        : cells_(new cell[capacity])
+        , mask_(capacity - 1)
+    {
+        assert((capacity && !(capacity & (capacity - 1))) && "capacity must be power of 2");
+        for (uint64_t i = 0; i < capacity; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool try_push(const T& value) noexcept {
+        uint64_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        while (true) {
+            cell& c = cells_[pos & mask_];
+            uint64_t seq = c.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<int64_t>(seq - pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    c.value = value;
+                    c.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;   // full
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool try_pop(T& value) noexcept {
+        uint64_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        while (true) {
+            cell& c = cells_[pos & mask_];
+            uint64_t seq = c.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<int64_t>(seq - (pos + 1));
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    value = c.value;
+                    c.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;   // empty
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+}   // end namespace slick::bench
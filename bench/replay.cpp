@@ -0,0 +1,257 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#include "bench.h"
+
+#include <unordered_map>
+
+/**
+ * @file replay.cpp
+ * @brief Offline replay of an AllocationTrace against other pool configurations
+ *
+ * @details
+ * Reads a trace written by slick::AllocationTrace and drives the recorded
+ * allocate/free sequence, in timestamp order, against every combination of:
+ * - capacity: total pool capacity
+ * - shards:   number of pools; recorded thread t allocates from shard t % shards
+ *             and objects are returned to the shard they came from
+ * - cache:    per-thread cache of freed objects consulted before the pool
+ *             (0 disables); full caches spill to the pool
+ *
+ * The replay is single threaded and deterministic: it answers "how many heap
+ * fallbacks would this configuration have taken on this workload", not how
+ * fast it would have run under contention.
+ *
+ * Reported per configuration: heap fallbacks, peak pool occupancy and replay
+ * throughput. The trace row reports the peak number of live objects, which is
+ * the capacity needed for zero fallbacks with a single shard and no cache.
+ *
+ * Usage:
+ *   slick_object_pool_replay --trace=<file> [options]
+ *
+ * Options:
+ *   --capacities=<list>      Total capacities (default: recorded capacity /2, x1, x2 and the peak)
+ *   --shards=1               Shard counts
+ *   --cache=0                Per-thread cache sizes
+ *   --engines=ring           Pool engines (this build has the ring engine only)
+ *   --json=<path> --csv=<path> --quiet
+ */
+namespace {
+
+using namespace slick::bench;
+using Event = slick::AllocationTrace::Event;
+
+struct TraceStats {
+    uint64_t events = 0;
+    uint64_t duration_ns = 0;
+    uint32_t threads = 0;
+    uint64_t unmatched_frees = 0;   ///< Frees of objects allocated before recording started
+    uint64_t peak_live = 0;
+};
+
+TraceStats analyze(const std::vector<Event>& events) {
+    TraceStats stats;
+    stats.events = events.size();
+    if (!events.empty()) {
+        stats.duration_ns = events.back().timestamp_ns - events.front().timestamp_ns;
+    }
+    std::unordered_map<uint32_t, bool> live;
+    live.reserve(1024);
+    for (auto& e : events) {
+        stats.threads = std::max<uint32_t>(stats.threads, e.thread + 1u);
+        if (e.type == slick::AllocationTrace::ALLOCATE || e.type == slick::AllocationTrace::ALLOCATE_HEAP) {
+            live[e.object] = true;
+            stats.peak_live = std::max<uint64_t>(stats.peak_live, live.size());
+        } else if (!live.erase(e.object)) {
+            ++stats.unmatched_frees;
+        }
+    }
+    return stats;
+}
+
+struct Config {
+    std::string engine;
+    uint32_t capacity;
+    uint32_t shards;
+    uint32_t cache;
+};
+
+template<typename P>
+Record replay(const std::vector<Event>& events, const TraceStats& stats, const Config& config) {
+    const uint32_t shard_capacity = std::bit_ceil(std::max<uint32_t>(1, config.capacity / config.shards));
+    std::vector<std::unique_ptr<slick::ObjectPool<P>>> shards;
+    for (uint32_t s = 0; s < config.shards; ++s) {
+        shards.push_back(std::make_unique<slick::ObjectPool<P>>(shard_capacity));
+    }
+
+    struct Held {
+        P* obj;
+        uint32_t shard;
+    };
+    std::vector<std::vector<Held>> caches(stats.threads);
+    for (auto& cache : caches) {
+        cache.reserve(config.cache);
+    }
+    std::unordered_map<uint32_t, Held> live;
+    live.reserve(static_cast<size_t>(stats.peak_live) * 2);
+
+    uint64_t allocations = 0;
+    uint64_t fallbacks = 0;
+    uint64_t cache_hits = 0;
+    uint64_t pooled_out = 0;        // pool objects outside their pool (live or cached)
+    uint64_t peak_pooled_out = 0;
+
+    auto release = [&](const Held& held) {
+        if (shards[held.shard]->owns(held.obj)) {
+            --pooled_out;
+        }
+        shards[held.shard]->free(held.obj);
+    };
+
+    auto start = clock::now();
+    for (auto& e : events) {
+        auto& cache = caches[e.thread];
+        if (e.type == slick::AllocationTrace::ALLOCATE || e.type == slick::AllocationTrace::ALLOCATE_HEAP) {
+            Held held;
+            ++allocations;
+            if (!cache.empty()) {
+                held = cache.back();
+                cache.pop_back();
+                ++cache_hits;
+            } else {
+                held.shard = e.thread % config.shards;
+                held.obj = shards[held.shard]->allocate();
+                if (shards[held.shard]->owns(held.obj)) {
+                    peak_pooled_out = std::max(peak_pooled_out, ++pooled_out);
+                } else {
+                    ++fallbacks;
+                }
+            }
+            do_not_optimize(held.obj);
+            live[e.object] = held;
+        } else {
+            auto it = live.find(e.object);
+            if (it == live.end()) {
+                continue;   // allocated before recording started
+            }
+            if (cache.size() < config.cache) {
+                cache.push_back(it->second);
+            } else {
+                release(it->second);
+            }
+            live.erase(it);
+        }
+    }
+    auto elapsed = static_cast<double>((clock::now() - start).count());
+
+    for (auto& [id, held] : live) {
+        release(held);
+    }
+    for (auto& cache : caches) {
+        for (auto& held : cache) {
+            release(held);
+        }
+    }
+
+    const double total_capacity = static_cast<double>(shard_capacity) * config.shards;
+    Record row;
+    row.add("engine", config.engine)
+        .add("capacity", static_cast<uint64_t>(total_capacity))
+        .add("shards", config.shards)
+        .add("cache", config.cache)
+        .add("heap_fallbacks", fallbacks)
+        .add("fallback_rate", allocations ? static_cast<double>(fallbacks) / allocations : 0.0)
+        .add("cache_hits", cache_hits)
+        .add("peak_pool_occupancy", peak_pooled_out)
+        .add("peak_pool_occupancy_frac", static_cast<double>(peak_pooled_out) / total_capacity)
+        .add("replay_events_per_sec", elapsed > 0 ? static_cast<double>(events.size()) / elapsed * 1e9 : 0.0);
+    return row;
+}
+
+void print_usage() {
+    std::cout << "Usage: slick_object_pool_replay --trace=<file> [options]\n\n"
+              << "  --capacities=<list>  Total capacities (default: recorded /2, x1, x2 and peak live)\n"
+              << "  --shards=<list>      Shard counts (default: 1)\n"
+              << "  --cache=<list>       Per-thread cache sizes (default: 0)\n"
+              << "  --engines=<list>     Pool engines (default: ring)\n"
+              << "  --json=<path>        Write results as JSON\n"
+              << "  --csv=<path>         Write results as CSV\n"
+              << "  --quiet              Do not print result rows\n";
+}
+
+}   // namespace
+
+int main(int argc, char** argv) {
+    try {
+        Options opts(argc, argv);
+        if (opts.has("help") || !opts.has("trace")) {
+            print_usage();
+            return opts.has("help") ? 0 : 1;
+        }
+
+        const auto path = opts.get("trace", "");
+        auto [header, events] = slick::AllocationTrace::load(path);
+        const auto stats = analyze(events);
+
+        Reporter reporter(opts);
+        Record summary;
+        summary.add("trace", path)
+            .add("recorded_capacity", header.capacity)
+            .add("object_size", header.object_size)
+            .add("events", stats.events)
+            .add("threads", stats.threads)
+            .add("duration_ms", static_cast<double>(stats.duration_ns) / 1e6)
+            .add("unmatched_frees", stats.unmatched_frees)
+            .add("peak_live", stats.peak_live)
+            .add("min_capacity", static_cast<uint64_t>(std::bit_ceil(std::max<uint64_t>(1, stats.peak_live))));
+        reporter.add(std::move(summary));
+        if (events.empty()) {
+            reporter.finish();
+            return 0;
+        }
+
+        std::vector<uint64_t> capacities;
+        if (opts.has("capacities")) {
+            capacities = opts.get_uint_list("capacities", "");
+        } else {
+            uint64_t recorded = std::max<uint32_t>(header.capacity, 2);
+            capacities = { recorded / 2, recorded, recorded * 2, std::bit_ceil(std::max<uint64_t>(1, stats.peak_live)) };
+            std::sort(capacities.begin(), capacities.end());
+            capacities.erase(std::unique(capacities.begin(), capacities.end()), capacities.end());
+        }
+        for (auto& engine : opts.get_list("engines", "ring")) {
+            if (engine != "ring") {
+                throw std::runtime_error("unknown engine " + engine + " (available: ring)");
+            }
+        }
+
+        // Replay with objects of the recorded size so cache behavior matches
+        size_t payload = std::clamp<size_t>(std::bit_ceil(std::max<size_t>(header.object_size, 8)), 8, 4096);
+        dispatch_payload(payload, [&]<size_t N>() {
+            for (auto& engine : opts.get_list("engines", "ring")) {
+                for (auto capacity : capacities) {
+                    for (auto shards : opts.get_uint_list("shards", "1")) {
+                        for (auto cache : opts.get_uint_list("cache", "0")) {
+                            Config config{ engine, static_cast<uint32_t>(capacity),
+                                static_cast<uint32_t>(std::max<uint64_t>(1, shards)), static_cast<uint32_t>(cache) };
+                            reporter.add(replay<Payload<N>>(events, stats, config));
+                        }
+                    }
+                }
+            }
+        });
+        reporter.finish();
+    } catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,148 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#include "bench.h"
+
+#include <slick/soa_object_pool.h>
+
+/**
+ * @file soa_bench.cpp
+ * @brief Hot-field scans over pooled orders: whole objects vs split field groups
+ *
+ * @details
+ * An order has a hot group (price, quantity, side) and a cold group of
+ * --cold bytes. The pool is filled, then every repetition scans the hot
+ * fields of all orders and sums their notional:
+ * - aos: ObjectPool<Order>, orders reached through the pointers allocate()
+ *        returned, as an order book holds them
+ * - soa: SoaObjectPool<Hot, Cold>, scanning array<Hot>()
+ *
+ * Also reports one allocate() plus one free() per pool.
+ *
+ * Options:
+ *   --capacities=4096,65536,1048576  Orders in the pool
+ *   --cold=64,256                    Cold group size in bytes (8..4096, powers of 2)
+ *   --repeat=5                       Repetitions
+ *   --ops=1000000                    allocate/free pairs per repetition
+ */
+namespace {
+
+using namespace slick::bench;
+
+struct Hot {
+    double price = 0;
+    uint32_t qty = 0;
+    uint8_t side = 0;
+};
+
+template<size_t N>
+struct Order {
+    Hot hot;
+    Payload<N> cold;
+};
+
+double elapsed_ns(clock::time_point start) {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count());
+}
+
+template<size_t N>
+void run_config(const Options& opts, Reporter& reporter, uint32_t capacity) {
+    const uint32_t repeat = static_cast<uint32_t>(std::max<uint64_t>(1, opts.get_uint("repeat", 5)));
+    const uint64_t ops = opts.get_uint("ops", 1000000);
+
+    auto aos = std::make_unique<slick::ObjectPool<Order<N>>>(capacity);
+    auto soa = std::make_unique<slick::SoaObjectPool<Hot, Payload<N>>>(capacity);
+    std::vector<Order<N>*> orders(capacity);
+    for (uint32_t i = 0; i < capacity; ++i) {
+        orders[i] = aos->allocate();
+        orders[i]->hot = { 100.0 + (i & 255), i & 1023u, static_cast<uint8_t>(i & 1) };
+        auto id = soa->allocate();
+        soa->template get<Hot>(id) = orders[i]->hot;
+    }
+
+    std::vector<double> aos_scan, soa_scan, aos_pair, soa_pair;
+    for (uint32_t rep = 0; rep < repeat; ++rep) {
+        auto start = clock::now();
+        double notional = 0;
+        for (auto* order : orders) {
+            notional += order->hot.price * order->hot.qty;
+        }
+        do_not_optimize(notional);
+        aos_scan.push_back(elapsed_ns(start) / capacity);
+
+        start = clock::now();
+        notional = 0;
+        for (const auto& hot : soa->template array<Hot>()) {
+            notional += hot.price * hot.qty;
+        }
+        do_not_optimize(notional);
+        soa_scan.push_back(elapsed_ns(start) / capacity);
+    }
+
+    // allocate/free with one object free in each pool
+    aos->free(orders.back());
+    soa->free(capacity - 1);
+    for (uint32_t rep = 0; rep < repeat; ++rep) {
+        auto start = clock::now();
+        for (uint64_t i = 0; i < ops; ++i) {
+            auto* order = aos->allocate();
+            order->hot.qty = static_cast<uint32_t>(i);
+            do_not_optimize(order);
+            aos->free(order);
+        }
+        aos_pair.push_back(elapsed_ns(start) / ops);
+
+        start = clock::now();
+        for (uint64_t i = 0; i < ops; ++i) {
+            auto id = soa->allocate();
+            soa->template get<Hot>(id).qty = static_cast<uint32_t>(i);
+            do_not_optimize(id);
+            soa->free(id);
+        }
+        soa_pair.push_back(elapsed_ns(start) / ops);
+    }
+    orders.pop_back();
+    for (auto* order : orders) {
+        aos->free(order);
+    }
+
+    auto aos_summary = summarize(aos_scan);
+    auto soa_summary = summarize(soa_scan);
+    Record row;
+    row.add("suite", "soa")
+        .add("capacity", capacity)
+        .add("hot_bytes", sizeof(Hot))
+        .add("cold_bytes", N)
+        .add("repeat", repeat)
+        .add("aos_scan_ns_per_order", aos_summary)
+        .add("soa_scan_ns_per_order", soa_summary)
+        .add("scan_speedup", soa_summary.median > 0 ? aos_summary.median / soa_summary.median : 0.0)
+        .add("aos_alloc_free_ns", summarize(aos_pair))
+        .add("soa_alloc_free_ns", summarize(soa_pair));
+    reporter.add(std::move(row));
+}
+
+void run_soa(const Options& opts, Reporter& reporter) {
+    for (auto cold : opts.get_uint_list("cold", "64,256")) {
+        for (auto capacity : opts.get_uint_list("capacities", "4096,65536,1048576")) {
+            bool known = dispatch_payload(cold, [&]<size_t N>() {
+                run_config<N>(opts, reporter, static_cast<uint32_t>(capacity));
+            });
+            if (!known) {
+                throw std::runtime_error("unsupported cold size " + std::to_string(cold));
+            }
+        }
+    }
+}
+
+}   // namespace
+
+SLICK_BENCH_SUITE(soa, "hot-field scans of pooled orders, whole objects vs SoaObjectPool field groups", run_soa);
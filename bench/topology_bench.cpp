@@ -0,0 +1,315 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#include "bench.h"
+#include "histogram.h"
+#include "queue.h"
+#include "tsc.h"
+
+#include <slick/thread_affine_pool.h>
+
+/**
+ * @file topology_bench.cpp
+ * @brief Allocate on one CPU, free on another: handoff cost per topology class
+ *
+ * @details
+ * An allocator thread allocates objects, stamps them with the TSC and passes
+ * them through a queue to a freer thread, which reads and frees them. The two
+ * threads are pinned to a pair of CPUs of each topology class, read from
+ * /sys/devices/system/cpu:
+ * - same_thread: allocate and free on one thread, through the same queue
+ * - smt:         SMT siblings of one core
+ * - l3:          different cores sharing an L3 cache
+ * - package:     same package, different L3
+ * - remote:      different packages
+ *
+ * Classes the host has no CPU pair for are skipped. Per class and pool:
+ * handoff latency (allocate to the freer receiving the object; needs an
+ * invariant TSC synchronized across CPUs), allocate and free cost, and
+ * throughput. --matrix additionally runs every ordered pair of the first
+ * --matrix-cpus CPUs and prints grids of p50 handoff latency and throughput.
+ *
+ * Options:
+ *   --pools=object       Pools to run: object (ObjectPool), affine (ThreadAffinePool)
+ *   --cpu=<first>        Allocator CPU of the class pairs (default: first available)
+ *   --capacity=4096      Pool capacity
+ *   --payload=64         Object size in bytes
+ *   --depth=64           Objects in flight (queue capacity, power of 2)
+ *   --ops=1000000        Objects handed off per pair
+ *   --matrix             Also run every ordered CPU pair
+ *   --matrix-cpus=8      CPUs in the matrix
+ */
+namespace {
+
+using namespace slick::bench;
+
+// ============================================================================
+// Topology
+// ============================================================================
+
+std::string read_line(const std::string& path) {
+    std::ifstream in(path);
+    std::string line;
+    std::getline(in, line);
+    return line;
+}
+
+struct CpuTopology {
+    int cpu = -1;
+    std::string core;       ///< thread_siblings_list: CPUs sharing the core
+    std::string l3;         ///< shared_cpu_list of the level 3 cache (empty if none)
+    std::string package;    ///< physical_package_id
+};
+
+CpuTopology read_topology(int cpu) {
+    const std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    CpuTopology topology;
+    topology.cpu = cpu;
+    topology.core = read_line(base + "/topology/thread_siblings_list");
+    topology.package = read_line(base + "/topology/physical_package_id");
+    for (int index = 0; index < 8; ++index) {
+        const std::string cache = base + "/cache/index" + std::to_string(index);
+        if (read_line(cache + "/level") == "3") {
+            topology.l3 = read_line(cache + "/shared_cpu_list");
+            break;
+        }
+    }
+    return topology;
+}
+
+enum Class : size_t { SAME_THREAD, SMT, L3, PACKAGE, REMOTE, CLASS_COUNT };
+
+constexpr const char* class_name(size_t c) noexcept {
+    constexpr const char* names[] = { "same_thread", "smt", "l3", "package", "remote" };
+    return names[c];
+}
+
+/**
+ * @brief Topology class of a pair of distinct CPUs, or CLASS_COUNT if unknown
+ */
+size_t classify(const CpuTopology& a, const CpuTopology& b) {
+    if (a.package.empty() || b.package.empty()) {
+        return CLASS_COUNT;
+    }
+    if (a.package != b.package) {
+        return REMOTE;
+    }
+    if (!a.core.empty() && a.core == b.core) {
+        return SMT;
+    }
+    if (!a.l3.empty() && a.l3 == b.l3) {
+        return L3;
+    }
+    return PACKAGE;
+}
+
+// ============================================================================
+// Handoff
+// ============================================================================
+
+struct PairResult {
+    LatencyHistogram handoff;
+    LatencyHistogram allocate;
+    LatencyHistogram free;
+    double mops = 0;
+};
+
+/**
+ * @brief Hand ops objects from a thread on cpu_a to one on cpu_b
+ * @details cpu_b < 0 runs both sides on one thread, one object at a time
+ */
+template<typename T, typename Pool>
+PairResult run_pair(Pool& pool, int cpu_a, int cpu_b, uint64_t depth, uint64_t ops, bool pin) {
+    PairResult result;
+    MpmcQueue<T*> queue(depth);
+
+    // The allocating side records allocate, the freeing side handoff and free
+    auto produce = [&] {
+        uint64_t s = Tsc::start();
+        T* obj = pool.allocate();
+        uint64_t e = Tsc::stop();
+        obj->id = e;
+        result.allocate.record(e - s);
+        return obj;
+    };
+    auto consume = [&](T* obj) {
+        uint64_t received = Tsc::stop();
+        result.handoff.record(received > obj->id ? received - obj->id : 0);
+        uint64_t s = Tsc::start();
+        pool.free(obj);
+        result.free.record(Tsc::stop() - s);
+    };
+
+    ThreadPlan plan;
+    plan.pin = pin;
+    plan.cpus = { cpu_a, cpu_b < 0 ? cpu_a : cpu_b };
+    std::chrono::nanoseconds elapsed;
+    if (cpu_b < 0) {
+        elapsed = run_threads(1, plan, [&](uint32_t) {
+            T* obj = nullptr;
+            for (uint64_t i = 0; i < ops; ++i) {
+                // One object in flight, so neither loop ever spins
+                obj = produce();
+                while (!queue.try_push(obj)) {
+                }
+                while (!queue.try_pop(obj)) {
+                }
+                consume(obj);
+            }
+        });
+    } else {
+        elapsed = run_threads(2, plan, [&](uint32_t t) {
+            T* obj = nullptr;
+            for (uint64_t i = 0; i < ops; ++i) {
+                if (t == 0) {
+                    obj = produce();
+                    while (!queue.try_push(obj)) {
+                    }
+                } else {
+                    while (!queue.try_pop(obj)) {
+                    }
+                    consume(obj);
+                }
+            }
+        });
+    }
+    result.mops = static_cast<double>(ops) / static_cast<double>(elapsed.count()) * 1e3;
+    return result;
+}
+
+template<typename T>
+PairResult run_pool(const std::string& pool_name, const Options& opts, int cpu_a, int cpu_b, bool pin) {
+    const uint32_t capacity = static_cast<uint32_t>(opts.get_uint("capacity", 4096));
+    const uint64_t depth = opts.get_uint("depth", 64);
+    const uint64_t ops = opts.get_uint("ops", 1000000);
+    if (!depth || (depth & (depth - 1))) {
+        throw std::runtime_error("depth must be a power of 2");
+    }
+    if (pool_name == "object") {
+        auto pool = std::make_unique<slick::ObjectPool<T>>(capacity);
+        run_pair<T>(*pool, cpu_a, cpu_b, depth, std::min<uint64_t>(ops, 10000), pin);   // warm-up
+        return run_pair<T>(*pool, cpu_a, cpu_b, depth, ops, pin);
+    }
+    if (pool_name == "affine") {
+        auto pool = std::make_unique<slick::ThreadAffinePool<T>>(capacity);
+        run_pair<T>(*pool, cpu_a, cpu_b, depth, std::min<uint64_t>(ops, 10000), pin);
+        return run_pair<T>(*pool, cpu_a, cpu_b, depth, ops, pin);
+    }
+    throw std::runtime_error("unknown pool " + pool_name);
+}
+
+template<size_t N>
+void run_classes(const Options& opts, Reporter& reporter, const std::vector<CpuTopology>& cpus, bool pin) {
+    using T = Payload<N>;
+    const int first = opts.has("cpu") ? static_cast<int>(opts.get_uint("cpu", 0)) : cpus.front().cpu;
+    auto a = std::find_if(cpus.begin(), cpus.end(), [&](const CpuTopology& c) { return c.cpu == first; });
+    if (a == cpus.end()) {
+        throw std::runtime_error("cpu " + std::to_string(first) + " is not available");
+    }
+
+    // One partner per class, the first available CPU in it
+    int partner[CLASS_COUNT];
+    std::fill(std::begin(partner), std::end(partner), -2);
+    partner[SAME_THREAD] = -1;
+    for (auto& b : cpus) {
+        if (b.cpu != a->cpu) {
+            auto c = classify(*a, b);
+            if (c < CLASS_COUNT && partner[c] == -2) {
+                partner[c] = b.cpu;
+            }
+        }
+    }
+
+    for (auto& pool_name : opts.get_list("pools", "object")) {
+        for (size_t c = 0; c < CLASS_COUNT; ++c) {
+            if (partner[c] == -2) {
+                std::cout << "# topology: no CPU pair of class " << class_name(c) << " with cpu " << a->cpu << std::endl;
+                continue;
+            }
+            auto result = run_pool<T>(pool_name, opts, a->cpu, partner[c], pin);
+            Record row;
+            row.add("suite", "topology")
+                .add("pool", pool_name)
+                .add("payload", N)
+                .add("class", class_name(c))
+                .add("cpu_a", a->cpu)
+                .add("cpu_b", partner[c] < 0 ? a->cpu : partner[c])
+                .add("mops", result.mops);
+            for (auto [name, h] : { std::pair{ "handoff", &result.handoff }, std::pair{ "allocate", &result.allocate },
+                     std::pair{ "free", &result.free } }) {
+                for (double p : { 50.0, 99.0, 99.9 }) {
+                    std::ostringstream key;
+                    key << name << "_p" << p << "_ns";
+                    row.add(key.str(), static_cast<double>(Tsc::to_ns(h->percentile(p))));
+                }
+            }
+            reporter.add(std::move(row));
+        }
+    }
+}
+
+template<size_t N>
+void run_matrix(const Options& opts, const std::vector<CpuTopology>& all, bool pin) {
+    using T = Payload<N>;
+    const size_t count = std::min<size_t>(all.size(), opts.get_uint("matrix-cpus", 8));
+    for (auto& pool_name : opts.get_list("pools", "object")) {
+        std::vector<std::vector<PairResult>> grid(count);
+        for (size_t i = 0; i < count; ++i) {
+            for (size_t j = 0; j < count; ++j) {
+                grid[i].push_back(run_pool<T>(pool_name, opts, all[i].cpu, i == j ? -1 : all[j].cpu, pin));
+            }
+        }
+        auto print = [&](const char* title, auto value) {
+            std::cout << "## " << pool_name << " " << title << " (row: allocating CPU, column: freeing CPU)\n" << std::setw(6) << "";
+            for (size_t j = 0; j < count; ++j) {
+                std::cout << std::setw(9) << all[j].cpu;
+            }
+            std::cout << "\n";
+            for (size_t i = 0; i < count; ++i) {
+                std::cout << std::setw(6) << all[i].cpu;
+                for (size_t j = 0; j < count; ++j) {
+                    std::cout << std::setw(9) << std::fixed << std::setprecision(1) << value(grid[i][j]);
+                }
+                std::cout << "\n";
+            }
+            std::cout << std::defaultfloat;
+        };
+        print("handoff p50 ns", [](const PairResult& r) { return static_cast<double>(Tsc::to_ns(r.handoff.percentile(50))); });
+        print("Mops", [](const PairResult& r) { return r.mops; });
+    }
+}
+
+void run_topology(const Options& opts, Reporter& reporter) {
+    std::vector<CpuTopology> cpus;
+    for (int cpu : available_cpus()) {
+        cpus.push_back(read_topology(cpu));
+    }
+    if (cpus.empty()) {
+        cpus.push_back(CpuTopology{ 0, "", "", "" });
+    }
+    const bool pin = !opts.get_bool("no-pin", false);
+    auto payload = opts.get_uint("payload", 64);
+    std::cout << "# time source: " << Tsc::source() << ", " << Tsc::ns_per_tick() << " ns/tick, " << cpus.size() << " CPUs" << std::endl;
+
+    bool known = dispatch_payload(payload, [&]<size_t N>() {
+        run_classes<N>(opts, reporter, cpus, pin);
+        if (opts.get_bool("matrix", false)) {
+            run_matrix<N>(opts, cpus, pin);
+        }
+    });
+    if (!known) {
+        throw std::runtime_error("unsupported payload size " + std::to_string(payload));
+    }
+}
+
+}   // namespace
+
+SLICK_BENCH_SUITE(topology, "allocate on one CPU, free on another: handoff latency and throughput per topology class", run_topology);
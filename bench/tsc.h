@@ -0,0 +1,115 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SLICK_BENCH_HAS_TSC 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace slick::bench {
+
+/**
+ * @brief Low-overhead timestamps for per-operation latency measurement
+ *
+ * @details
+ * On x86 uses the TSC: start() is `lfence; rdtsc` so earlier instructions retire
+ * first, stop() is `rdtscp; lfence` so the measured code completes and later code
+ * does not start early. On AArch64 uses the virtual counter (CNTVCT_EL0) with
+ * `isb` barriers. Elsewhere falls back to steady_clock in nanoseconds.
+ * Ticks are converted with a factor calibrated against steady_clock.
+ */
+class Tsc {
+public:
+    static inline uint64_t start() noexcept {
+#if defined(SLICK_BENCH_HAS_TSC)
+        _mm_lfence();
+        return __rdtsc();
+#elif defined(__aarch64__)
+        uint64_t v;
+        asm volatile("isb; mrs %0, cntvct_el0" : "=r"(v) :: "memory");
+        return v;
+#else
+        return steady_ns();
+#endif
+    }
+
+    static inline uint64_t stop() noexcept {
+#if defined(SLICK_BENCH_HAS_TSC)
+        unsigned aux;
+        uint64_t v = __rdtscp(&aux);
+        _mm_lfence();
+        return v;
+#elif defined(__aarch64__)
+        uint64_t v;
+        asm volatile("isb; mrs %0, cntvct_el0; isb" : "=r"(v) :: "memory");
+        return v;
+#else
+        return steady_ns();
+#endif
+    }
+
+    /// Nanoseconds per tick, calibrated once per process
+    static double ns_per_tick() {
+        static const double factor = calibrate();
+        return factor;
+    }
+
+    static uint64_t to_ns(uint64_t ticks) {
+        return static_cast<uint64_t>(static_cast<double>(ticks) * ns_per_tick() + 0.5);
+    }
+
+    static uint64_t from_ns(uint64_t ns) {
+        return static_cast<uint64_t>(static_cast<double>(ns) / ns_per_tick() + 0.5);
+    }
+
+    /// Human readable name of the time source
+    static const char* source() noexcept {
+#if defined(SLICK_BENCH_HAS_TSC)
+        return "rdtsc";
+#elif defined(__aarch64__)
+        return "cntvct";
+#else
+        return "steady_clock";
+#endif
+    }
+
+private:
+    static uint64_t steady_ns() noexcept {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    static double calibrate() {
+#if defined(SLICK_BENCH_HAS_TSC) || defined(__aarch64__)
+        auto t0 = std::chrono::steady_clock::now();
+        auto c0 = start();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        auto t1 = std::chrono::steady_clock::now();
+        auto c1 = stop();
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+        return c1 > c0 ? static_cast<double>(ns) / static_cast<double>(c1 - c0) : 1.0;
+#else
+        return 1.0;
+#endif
+    }
+};
+
+}   // end namespace slick::bench
@@ -0,0 +1,328 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace slick {
+
+/**
+ * @file allocation_trace.h
+ * @brief Compact binary recorder of pool allocate/free events
+ *
+ * @details
+ * An AllocationTrace attached to an ObjectPool (ObjectPool::trace()) records
+ * every allocate() and free() as a 16-byte event: timestamp, thread and
+ * object index. Events are appended to a per-thread buffer without any
+ * synchronization and written to the file in blocks, so the hot path costs
+ * one clock read and one store. Objects that came from the heap fallback are
+ * identified by a key derived from their address (see heap_object_id()).
+ *
+ * The file starts with a Header, followed by Event records. Blocks from
+ * different threads are interleaved, load() returns the events sorted by time.
+ * Traces are meant to be replayed offline against other pool configurations,
+ * see the slick_object_pool_replay tool.
+ *
+ * @section trace_layout File Layout
+ * @code
+ * [Header  40 bytes  magic "SLKTRACE", version, capacity, object size, event/thread counts]
+ * [Event   16 bytes  timestamp_ns (8), object (4), thread (2), type (1), reserved (1)]
+ * [Event   ...]
+ * @endcode
+ *
+ * @section trace_thread_safety Thread Safety
+ * - record() may be called concurrently from any number of threads
+ * - flush() and close() require that no thread is recording
+ *
+ * @par Example
+ * @code
+ * slick::AllocationTrace trace("orders.trace");
+ * pool.trace(&trace);
+ * // ... run ...
+ * pool.trace(nullptr);
+ * trace.close();
+ * @endcode
+ */
+class AllocationTrace {
+public:
+    /// Event kinds
+    enum EventType : uint8_t {
+        ALLOCATE = 0,       ///< Object handed out from the pool
+        ALLOCATE_HEAP,      ///< Pool exhausted, object allocated from heap
+        FREE,               ///< Object returned to the pool
+        FREE_HEAP,          ///< Heap-allocated object deleted
+    };
+
+    /// Bit set in the object id of heap-allocated objects
+    static constexpr uint32_t HEAP_OBJECT = 0x80000000u;
+    static constexpr uint32_t VERSION = 1;
+
+    /// One allocate/free event
+    struct Event {
+        uint64_t timestamp_ns;  ///< Nanoseconds since the trace was opened
+        uint32_t object;        ///< Pool index, or heap_object_id() for heap objects
+        uint16_t thread;        ///< Sequential id of the recording thread
+        uint8_t type;           ///< EventType
+        uint8_t reserved;
+    };
+    static_assert(sizeof(Event) == 16, "trace events must stay 16 bytes");
+
+    /// File header
+    struct Header {
+        char magic[8];          ///< "SLKTRACE"
+        uint32_t version;       ///< Format version
+        uint32_t event_size;    ///< sizeof(Event)
+        uint32_t capacity;      ///< Capacity of the traced pool
+        uint32_t object_size;   ///< sizeof(T) of the traced pool
+        uint32_t threads;       ///< Number of recording threads
+        uint32_t reserved;
+        uint64_t events;        ///< Number of events in the file
+    };
+    static_assert(sizeof(Header) == 40, "unexpected trace header layout");
+
+    /**
+     * @brief Open a trace file for writing
+     *
+     * @param path Output file (truncated)
+     * @param buffer_events Events buffered per thread before a block is written
+     *
+     * @throws std::runtime_error If the file cannot be opened
+     */
+    explicit AllocationTrace(const std::string& path, uint32_t buffer_events = 4096)
+        : id_(next_id().fetch_add(1, std::memory_order_relaxed) + 1)
+        , buffer_events_(buffer_events ? buffer_events : 1)
+        , start_(clock::now())
+    {
+        file_ = std::fopen(path.c_str(), "wb");
+        if (!file_) {
+            throw std::runtime_error("failed to open allocation trace " + path);
+        }
+        write_header();
+    }
+
+    /**
+     * @brief Flush buffered events and close the file
+     */
+    ~AllocationTrace() noexcept {
+        close();
+    }
+
+    AllocationTrace(const AllocationTrace&) = delete;
+    AllocationTrace& operator=(const AllocationTrace&) = delete;
+    AllocationTrace(AllocationTrace&&) = delete;
+    AllocationTrace& operator=(AllocationTrace&&) = delete;
+
+    /**
+     * @brief Describe the traced pool in the file header
+     * @param capacity Pool capacity
+     * @param object_size sizeof(T)
+     */
+    void attach(uint32_t capacity, uint32_t object_size) noexcept {
+        capacity_.store(capacity, std::memory_order_relaxed);
+        object_size_.store(object_size, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Record one event
+     *
+     * @param type Event kind
+     * @param object Pool index or heap_object_id()
+     *
+     * @note Lock-free unless the calling thread's buffer is full
+     */
+    void record(EventType type, uint32_t object) noexcept {
+        auto& buffer = local_buffer();
+        if (buffer.count == buffer_events_) [[unlikely]] {
+            write_block(buffer);
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start_);
+        buffer.events[buffer.count++] = Event{ static_cast<uint64_t>(elapsed.count()), object, buffer.thread, type, 0 };
+    }
+
+    /**
+     * @brief Id recorded for a heap-allocated object
+     *
+     * @details
+     * Derived from the address, so it is unique among live heap objects in
+     * practice (two live objects would have to be a multiple of 32 GB apart).
+     * Pool indices never have HEAP_OBJECT set.
+     */
+    static uint32_t heap_object_id(const void* obj) noexcept {
+        return HEAP_OBJECT | (static_cast<uint32_t>(reinterpret_cast<uintptr_t>(obj) >> 4) & ~HEAP_OBJECT);
+    }
+
+    /**
+     * @brief Write all buffered events and update the header
+     * @warning No thread may be recording
+     */
+    void flush() noexcept {
+        std::lock_guard lock(mutex_);
+        if (!file_) {
+            return;
+        }
+        for (auto& buffer : buffers_) {
+            write_locked(*buffer);
+        }
+        write_header();
+        std::fflush(file_);
+    }
+
+    /**
+     * @brief Flush and close the file; further events are dropped
+     * @warning No thread may be recording
+     */
+    void close() noexcept {
+        flush();
+        std::lock_guard lock(mutex_);
+        if (file_) {
+            std::fclose(file_);
+            file_ = nullptr;
+        }
+    }
+
+    /// Number of events written to the file so far
+    uint64_t events() const noexcept {
+        return written_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Read a trace file
+     *
+     * @param path Trace written by AllocationTrace
+     * @return Header and events sorted by timestamp
+     *
+     * @throws std::runtime_error If the file is missing or not a trace
+     */
+    static std::pair<Header, std::vector<Event>> load(const std::string& path) {
+        std::unique_ptr<std::FILE, int(*)(std::FILE*)> file(std::fopen(path.c_str(), "rb"), &std::fclose);
+        if (!file) {
+            throw std::runtime_error("failed to open allocation trace " + path);
+        }
+        Header header{};
+        if (std::fread(&header, sizeof(header), 1, file.get()) != 1
+            || std::memcmp(header.magic, "SLKTRACE", sizeof(header.magic)) != 0) {
+            throw std::runtime_error(path + " is not an allocation trace");
+        }
+        if (header.version != VERSION || header.event_size != sizeof(Event)) {
+            throw std::runtime_error("unsupported allocation trace version " + std::to_string(header.version));
+        }
+        std::vector<Event> events(header.events);
+        if (std::fread(events.data(), sizeof(Event), events.size(), file.get()) != events.size()) {
+            throw std::runtime_error(path + " is truncated");
+        }
+        std::stable_sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
+            return a.timestamp_ns < b.timestamp_ns;
+        });
+        return { header, std::move(events) };
+    }
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    /// Per-thread event buffer, written by its owner thread only
+    struct ThreadBuffer {
+        std::thread::id owner;
+        uint16_t thread = 0;
+        uint32_t count = 0;
+        std::unique_ptr<Event[]> events;
+    };
+
+    /// Last trace used by this thread, so the hot path skips the registry
+    struct ThreadCache {
+        uint64_t trace = 0;
+        ThreadBuffer* buffer = nullptr;
+    };
+
+    static std::atomic_uint64_t& next_id() noexcept {
+        static std::atomic_uint64_t id{ 0 };
+        return id;
+    }
+
+    ThreadBuffer& local_buffer() {
+        static thread_local ThreadCache cache;
+        if (cache.trace != id_) [[unlikely]] {
+            cache.buffer = &register_thread();
+            cache.trace = id_;
+        }
+        return *cache.buffer;
+    }
+
+    ThreadBuffer& register_thread() {
+        std::lock_guard lock(mutex_);
+        auto self = std::this_thread::get_id();
+        for (auto& buffer : buffers_) {
+            if (buffer->owner == self) {
+                return *buffer;
+            }
+        }
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->owner = self;
+        buffer->thread = static_cast<uint16_t>(buffers_.size());
+        buffer->events = std::make_unique<Event[]>(buffer_events_);
+        buffers_.push_back(std::move(buffer));
+        return *buffers_.back();
+    }
+
+    void write_block(ThreadBuffer& buffer) noexcept {
+        std::lock_guard lock(mutex_);
+        write_locked(buffer);
+    }
+
+    void write_locked(ThreadBuffer& buffer) noexcept {
+        if (file_ && buffer.count) {
+            auto written = std::fwrite(buffer.events.get(), sizeof(Event), buffer.count, file_);
+            written_.fetch_add(written, std::memory_order_relaxed);
+        }
+        buffer.count = 0;
+    }
+
+    void write_header() noexcept {
+        Header header{};
+        std::memcpy(header.magic, "SLKTRACE", sizeof(header.magic));
+        header.version = VERSION;
+        header.event_size = sizeof(Event);
+        header.capacity = capacity_.load(std::memory_order_relaxed);
+        header.object_size = object_size_.load(std::memory_order_relaxed);
+        header.threads = static_cast<uint32_t>(buffers_.size());
+        header.events = written_.load(std::memory_order_relaxed);
+        auto position = std::ftell(file_);
+        std::fseek(file_, 0, SEEK_SET);
+        std::fwrite(&header, sizeof(header), 1, file_);
+        if (position > 0) {
+            std::fseek(file_, position, SEEK_SET);
+        }
+    }
+
+    const uint64_t id_;                 ///< Process-unique trace id (keys the per-thread cache)
+    const uint32_t buffer_events_;      ///< Events per thread buffer
+    const clock::time_point start_;     ///< Timestamp origin
+    std::FILE* file_ = nullptr;         ///< Output file
+    std::mutex mutex_;                  ///< Guards file_ and buffers_
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;  ///< One buffer per recording thread
+    std::atomic_uint64_t written_{ 0 }; ///< Events written to file_
+    std::atomic_uint32_t capacity_{ 0 };
+    std::atomic_uint32_t object_size_{ 0 };
+};
+
+}   // end namespace slick
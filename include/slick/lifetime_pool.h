@@ -0,0 +1,294 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#pragma once
+
+#include "object_pool.h"
+
+#include <numeric>
+
+namespace slick {
+
+/**
+ * @brief Expected lifetime of an object, chosen at allocation
+ */
+enum class Lifetime : uint8_t {
+    SHORT_LIVED,    ///< Freed soon after allocation (quotes, messages, tasks)
+    LONG_LIVED,     ///< Kept for a long time (resting orders, sessions)
+};
+
+/**
+ * @file lifetime_pool.h
+ * @brief Lock-free pool segregating short-lived and long-lived objects
+ *
+ * @details
+ * In an ObjectPool, objects kept for hours end up scattered over the whole
+ * buffer, so short-lived churn keeps cycling through cache lines shared with
+ * cold, long-lived objects. LifetimePool splits one buffer into two regions,
+ * each with its own lock-free ring:
+ *
+ * @code
+ * [short-lived region: short_size objects][long-lived region: long_size objects]
+ * @endcode
+ *
+ * allocate(Lifetime::SHORT_LIVED) only hands out objects of the short-lived
+ * region, so the short-lived working set stays within short_size objects and
+ * remains cache-resident when the region is sized to the short-lived peak.
+ * free() finds the region from the address, and owns() is one range check
+ * covering both regions. The long-lived region starts on a cache line
+ * boundary, so no cache line holds objects of both regions.
+ *
+ * A region that is exhausted falls back to the heap, as with ObjectPool; it
+ * never borrows from the other region.
+ *
+ * @par Example
+ * @code
+ * slick::LifetimePool<Order> orders(1024, 1 << 16);
+ *
+ * Order* quote = orders.allocate(slick::Lifetime::SHORT_LIVED);
+ * Order* resting = orders.allocate(slick::Lifetime::LONG_LIVED);
+ * ...
+ * orders.free(quote);     // back to the short-lived region
+ * orders.free(resting);   // back to the long-lived region
+ * @endcode
+ *
+ * @tparam T Object type to pool
+ */
+template<typename T>
+class LifetimePool {
+    static_assert(std::is_default_constructible_v<T>, "T must be default constructible");
+
+    /// Hardware cache line size (typically 64 bytes, auto-detected if available)
+#ifdef __cpp_lib_hardware_interference_size
+    static constexpr size_t CACHE_LINE_SIZE = std::hardware_destructive_interference_size;
+#else
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+#endif
+
+    static constexpr std::align_val_t buffer_alignment{ std::max(alignof(T), CACHE_LINE_SIZE) };
+
+    /// Objects per cache line boundary: region starts are rounded up to a multiple of this
+    static constexpr uint32_t LINE_STRIDE = static_cast<uint32_t>(CACHE_LINE_SIZE / std::gcd(sizeof(T), CACHE_LINE_SIZE));
+
+    /**
+     * @brief Lock-free ring handing out the objects of one region
+     * @details Object indices in the ring are relative to the region start
+     */
+    struct Region {
+        uint32_t first_;            ///< Index of the region's first object in buffer_
+        detail::PoolRing ring_;     ///< Free objects of the region, initial fill [0, size)
+
+        Region(uint32_t first, uint32_t size)
+            : first_(first)
+            , ring_(size, size)
+        {}
+
+        /// Objects in the region
+        uint32_t size() const noexcept {
+            return ring_.size();
+        }
+    };
+
+    Region regions_[2];             ///< Indexed by Lifetime
+    T* buffer_ = nullptr;           ///< Both regions; objects between them (alignment gap) are never constructed
+    intptr_t lower_bound_ = 0;      ///< Lower address bound for pool ownership check
+    intptr_t upper_bound_ = 0;      ///< Upper address bound for pool ownership check
+    uint32_t extent_ = 0;           ///< Objects spanned by buffer_, gap included
+
+public:
+    /// Returned by index_of() for objects the pool does not own
+    static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * @brief Construct a pool with both regions fully available
+     *
+     * @param short_size Objects in the short-lived region (must be power of 2)
+     * @param long_size Objects in the long-lived region (must be power of 2)
+     */
+    LifetimePool(uint32_t short_size, uint32_t long_size)
+        : regions_{ { 0, short_size }, { long_offset(short_size), long_size } }
+        , extent_(long_offset(short_size) + long_size)
+    {
+        buffer_ = static_cast<T*>(::operator new(sizeof(T) * size_t(extent_), buffer_alignment));
+        for (auto& region : regions_) {
+            for (uint32_t i = 0; i < region.size(); ++i) {
+                new (&buffer_[region.first_ + i]) T;
+            }
+        }
+        lower_bound_ = reinterpret_cast<intptr_t>(&buffer_[0]);
+        upper_bound_ = reinterpret_cast<intptr_t>(&buffer_[extent_ - 1]);
+    }
+
+    ~LifetimePool() noexcept {
+        for (auto& region : regions_) {
+            for (uint32_t i = 0; i < region.size(); ++i) {
+                buffer_[region.first_ + i].~T();
+            }
+        }
+        ::operator delete(buffer_, buffer_alignment);
+        buffer_ = nullptr;
+    }
+
+    // Delete copy and move operations
+    LifetimePool(const LifetimePool&) = delete;
+    LifetimePool& operator=(const LifetimePool&) = delete;
+    LifetimePool(LifetimePool&&) = delete;
+    LifetimePool& operator=(LifetimePool&&) = delete;
+
+    /**
+     * @brief Allocate an object from the region matching its expected lifetime
+     *
+     * @param hint Expected lifetime of the object
+     * @return Pointer to allocated object (never nullptr; from the heap if the region is exhausted)
+     *
+     * @par Thread Safety
+     * Safe to call concurrently from multiple threads (lock-free unless the
+     * region falls back to the heap)
+     */
+    T* allocate(Lifetime hint) {
+        auto& region = regions_[size_t(hint)];
+        uint32_t object = region.ring_.consume();
+        if (object == detail::PoolRing::npos) [[unlikely]] {
+            return new T();
+        }
+        return &buffer_[region.first_ + object];
+    }
+
+    /**
+     * @brief Return an object to its region, or delete it if it came from the heap
+     *
+     * @param obj Object returned by allocate() (must not be nullptr)
+     *
+     * @warning Do not free the same object twice
+     */
+    void free(T* obj) {
+        if (!owns(obj)) {
+            delete obj;
+            return;
+        }
+        auto index = static_cast<uint32_t>(obj - buffer_);
+        auto& region = regions_[size_t(index >= regions_[size_t(Lifetime::LONG_LIVED)].first_)];
+        region.ring_.publish(region.ring_.reserve(), index - region.first_);
+    }
+
+    /**
+     * @brief Check whether an object lives in either region
+     *
+     * @param obj Object pointer
+     * @return true if obj is a pool slot, false if it came from the heap fallback
+     */
+    bool owns(const T* obj) const noexcept {
+        auto o = reinterpret_cast<intptr_t>(obj);
+        return o >= lower_bound_ && o <= upper_bound_;
+    }
+
+    /**
+     * @brief Region an owned object belongs to
+     * @param obj Object pointer (must be owned by the pool)
+     */
+    Lifetime lifetime_of(const T* obj) const noexcept {
+        assert(owns(obj) && "object does not belong to the pool");
+        auto index = static_cast<uint32_t>(obj - buffer_);
+        return index >= regions_[size_t(Lifetime::LONG_LIVED)].first_ ? Lifetime::LONG_LIVED : Lifetime::SHORT_LIVED;
+    }
+
+    /**
+     * @brief Index of a pool object in the pool's storage
+     * @return Index in [0, extent()), or npos for heap fallback objects
+     */
+    uint32_t index_of(const T* obj) const noexcept {
+        return owns(obj) ? static_cast<uint32_t>(obj - buffer_) : npos;
+    }
+
+    /**
+     * @brief Object at an index returned by index_of()
+     */
+    T& object_at(uint32_t index) noexcept {
+        assert(index < extent_);
+        return buffer_[index];
+    }
+
+    /// @copydoc object_at()
+    const T& object_at(uint32_t index) const noexcept {
+        assert(index < extent_);
+        return buffer_[index];
+    }
+
+    /**
+     * @brief Number of objects spanned by the pool's storage (both regions and the gap between them)
+     */
+    uint32_t extent() const noexcept {
+        return extent_;
+    }
+
+    /**
+     * @brief Get the capacity of one region
+     */
+    uint32_t size(Lifetime hint) const noexcept {
+        return regions_[size_t(hint)].size();
+    }
+
+    /**
+     * @brief Get the capacity of both regions
+     */
+    uint32_t size() const noexcept {
+        return size(Lifetime::SHORT_LIVED) + size(Lifetime::LONG_LIVED);
+    }
+
+    /**
+     * @brief Approximate number of objects ready to be allocated from one region
+     * @details Exact only while no other thread runs
+     */
+    uint32_t available(Lifetime hint) const noexcept {
+        const auto& region = regions_[size_t(hint)];
+        return static_cast<uint32_t>(std::min<uint64_t>(region.ring_.available(), region.size()));
+    }
+
+    /**
+     * @brief Approximate number of objects ready to be allocated from both regions
+     */
+    uint32_t available() const noexcept {
+        return available(Lifetime::SHORT_LIVED) + available(Lifetime::LONG_LIVED);
+    }
+
+    /**
+     * @brief Memory a pool with the given region sizes occupies
+     * @details Objects skipped to align the long-lived region count as padding
+     */
+    static constexpr MemoryUsage footprint(uint32_t short_size, uint32_t long_size) noexcept {
+        constexpr uint64_t region_used = sizeof(Region::first_) + detail::PoolRing::state_bytes();
+        constexpr uint64_t state_used = 2 * region_used + sizeof(buffer_) + sizeof(lower_bound_) + sizeof(upper_bound_)
+            + sizeof(extent_);
+
+        const uint64_t capacity = uint64_t(short_size) + long_size;
+        MemoryUsage usage;
+        usage.capacity = capacity;
+        usage.payload_bytes = capacity * sizeof(T);
+        usage.metadata_bytes = capacity * sizeof(detail::PoolRing::slot) + state_used;
+        usage.padding_bytes = sizeof(LifetimePool) - state_used + uint64_t(long_offset(short_size) - short_size) * sizeof(T);
+        return usage;
+    }
+
+    /**
+     * @brief Memory this pool occupies
+     */
+    MemoryUsage memory_usage() const noexcept {
+        return footprint(size(Lifetime::SHORT_LIVED), size(Lifetime::LONG_LIVED));
+    }
+
+private:
+    /// Start of the long-lived region: short_size rounded up to the next cache line boundary
+    static constexpr uint32_t long_offset(uint32_t short_size) noexcept {
+        return (short_size + LINE_STRIDE - 1) / LINE_STRIDE * LINE_STRIDE;
+    }
+};
+
+}   // end namespace slick
@@ -0,0 +1,160 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace slick {
+
+namespace detail {
+
+/**
+ * @file maintenance_thread.h
+ * @brief Background thread running a group of pool maintenance tasks
+ *
+ * @details
+ * Shared by PoolReplenisher and PoolScrubber. Each task maintains one pool
+ * and returns how much work it did (segments grown, objects recycled). The
+ * thread runs all tasks in a pass and starts the next pass right away while
+ * any task did work, otherwise it sleeps for the interval. Each pass holds
+ * the thread's mutex, so passes from run_once() on another thread and add()
+ * while running are safe; the thread releases it between passes, so stop(),
+ * add() and run_once() get through even while every pass finds work.
+ */
+class MaintenanceThread {
+public:
+    using clock = std::chrono::steady_clock;
+    using task = std::function<uint64_t()>;
+
+    /**
+     * @brief Create a stopped thread
+     * @param interval Sleep between passes that did no work
+     * @param idle_priority Run the thread under SCHED_IDLE (Linux only)
+     */
+    MaintenanceThread(clock::duration interval, bool idle_priority)
+        : interval_(interval)
+        , idle_priority_(idle_priority)
+    {}
+
+    ~MaintenanceThread() {
+        stop();
+    }
+
+    MaintenanceThread(const MaintenanceThread&) = delete;
+    MaintenanceThread& operator=(const MaintenanceThread&) = delete;
+
+    /**
+     * @brief Add a task to every following pass
+     * @note May be called while running
+     */
+    void add(task t) {
+        std::lock_guard lock(mutex_);
+        tasks_.push_back(std::move(t));
+    }
+
+    /**
+     * @brief Start the thread (no-op if running)
+     */
+    void start() {
+        std::lock_guard lock(mutex_);
+        if (thread_.joinable()) {
+            return;
+        }
+        stop_.store(false, std::memory_order_relaxed);
+        thread_ = std::thread([this] { run(); });
+#if defined(__linux__)
+        if (idle_priority_) {
+            sched_param param{};
+            pthread_setschedparam(thread_.native_handle(), SCHED_IDLE, &param);
+        }
+#endif
+    }
+
+    /**
+     * @brief Stop and join the thread
+     * @details The thread finishes the pass it is in, if any
+     */
+    void stop() {
+        stop_.store(true, std::memory_order_relaxed);
+        {
+            // Not waiting in wait_for() yet means the thread sees stop_ before it does
+            std::lock_guard lock(mutex_);
+        }
+        wake_.notify_all();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    /**
+     * @brief Run one pass on the calling thread
+     * @return Work done by all tasks
+     */
+    uint64_t run_once() {
+        std::lock_guard lock(mutex_);
+        return pass();
+    }
+
+    /// Work done by all passes so far
+    uint64_t work() const noexcept {
+        return work_.load(std::memory_order_relaxed);
+    }
+
+private:
+    uint64_t pass() {
+        uint64_t done = 0;
+        for (auto& t : tasks_) {
+            done += t();
+        }
+        work_.fetch_add(done, std::memory_order_relaxed);
+        return done;
+    }
+
+    void run() {
+        while (!stop_.load(std::memory_order_relaxed)) {
+            std::unique_lock lock(mutex_);
+            // Keep going while there is work, sleep once a pass finds none
+            if (pass() == 0) {
+                wake_.wait_for(lock, interval_, [this] { return stop_.load(std::memory_order_relaxed); });
+            } else {
+                // Let add(), run_once() and stop() take the mutex between busy passes
+                lock.unlock();
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    clock::duration interval_;          ///< Sleep between passes that did no work
+    bool idle_priority_;                ///< Thread runs under SCHED_IDLE
+    std::mutex mutex_;                  ///< Guards tasks_, held for one pass at a time
+    std::condition_variable wake_;      ///< Wakes the thread on stop()
+    std::vector<task> tasks_;           ///< One task per maintained pool
+    std::thread thread_;
+    std::atomic_bool stop_{ false };
+    std::atomic_uint64_t work_{ 0 };
+};
+
+}   // end namespace detail
+
+}   // end namespace slick
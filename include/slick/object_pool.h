@@ -12,14 +12,342 @@
 #pragma once
 
 #include <cstdint>
+#include <cstdlib>
 #include <atomic>
 #include <stdexcept>
 #include <string>
 #include <cassert>
 #include <limits>
+#include <chrono>
+#include <bit>
+#include <algorithm>
+#include <type_traits>
+#include <cstdio>
+#include <cstring>
+#include <concepts>
+#include <filesystem>
+#include <mutex>
+#include <new>
+#include <tuple>
+
+#include "allocation_trace.h"
+#include "pool_ring.h"
+
+/**
+ * @def SLICK_OBJECT_POOL_PROBE
+ * @brief USDT (SystemTap SDT compatible) static tracepoint
+ *
+ * @details
+ * Each probe site emits a single NOP and a `.note.stapsdt` ELF note describing
+ * the probe location and its arguments, so `perf probe`, `bpftrace` and
+ * SystemTap can attach to a running process without recompiling.
+ * The note is generated with inline assembly, so <sys/sdt.h> is not required.
+ * All arguments are passed as 64-bit unsigned values.
+ *
+ * Probes are available on Linux (x86-64, AArch64) with GCC or Clang and expand
+ * to nothing elsewhere. Define SLICK_OBJECT_POOL_DISABLE_USDT to compile them out.
+ *
+ * @par Example
+ * @code
+ * bpftrace -e 'usdt:./app:slick_object_pool:allocate_fallback { @[ustack] = count(); }'
+ * @endcode
+ */
+#if !defined(SLICK_OBJECT_POOL_DISABLE_USDT) && defined(__linux__) && (defined(__GNUC__) || defined(__clang__)) \
+    && (defined(__x86_64__) || defined(__aarch64__))
+#define SLICK_OBJECT_POOL_HAS_USDT 1
+
+#define SLICK_OBJECT_POOL_USDT_ASM(name, args)                                  \
+    "990: nop\n"                                                                \
+    ".pushsection .note.stapsdt,\"?\",\"note\"\n"                               \
+    ".balign 4\n"                                                               \
+    ".4byte 992f-991f, 994f-993f, 3\n"                                          \
+    "991: .asciz \"stapsdt\"\n"                                                 \
+    "992: .balign 4\n"                                                          \
+    "993: .8byte 990b\n"                                                        \
+    ".8byte _.stapsdt.base\n"                                                   \
+    ".8byte 0\n"                                                                \
+    ".asciz \"slick_object_pool\"\n"                                            \
+    ".asciz \"" #name "\"\n"                                                    \
+    ".asciz \"" args "\"\n"                                                     \
+    "994: .balign 4\n"                                                          \
+    ".popsection\n"                                                             \
+    ".ifndef _.stapsdt.base\n"                                                  \
+    ".pushsection .stapsdt.base,\"aG\",\"progbits\",.stapsdt.base,comdat\n"     \
+    ".weak _.stapsdt.base\n"                                                    \
+    ".hidden _.stapsdt.base\n"                                                  \
+    "_.stapsdt.base: .space 1\n"                                                \
+    ".size _.stapsdt.base, 1\n"                                                 \
+    ".popsection\n"                                                             \
+    ".endif\n"
+
+#define SLICK_OBJECT_POOL_PROBE(name, a1, a2)                                   \
+    __asm__ __volatile__(SLICK_OBJECT_POOL_USDT_ASM(name, "8@%0 8@%1")          \
+        :: "r"(static_cast<uint64_t>(a1)), "r"(static_cast<uint64_t>(a2)))
+#else
+#define SLICK_OBJECT_POOL_PROBE(name, a1, a2) ((void)0)
+#endif
 
 namespace slick {
 
+/**
+ * @brief CAS contention statistics for a single call site
+ *
+ * @details
+ * Every operation that executes the site's CAS loop is recorded once, with the
+ * number of CAS attempts it needed. Bucket i of the histogram counts operations
+ * needing [2^(i-1) + 1, 2^i] attempts, i.e. 1, 2, 3-4, 5-8, ..., and the last
+ * bucket collects everything above.
+ */
+struct CasSiteProfile {
+    static constexpr size_t HISTOGRAM_BUCKETS = 8;
+
+    uint64_t operations = 0;    ///< Operations that ran the CAS loop
+    uint64_t attempts = 0;      ///< Total CAS attempts (successful and failed)
+    uint64_t retry_ns = 0;      ///< Time spent between the first failed CAS and completion
+    uint64_t histogram[HISTOGRAM_BUCKETS] = {};  ///< Attempts-per-operation histogram
+
+    /// Lower bound (inclusive) of the attempt count covered by histogram bucket
+    static constexpr uint64_t bucket_lower_bound(size_t bucket) noexcept {
+        return bucket == 0 ? 1 : (uint64_t(1) << (bucket - 1)) + 1;
+    }
+
+    /// Histogram bucket for an operation that needed `attempts` CAS attempts
+    static constexpr size_t bucket_of(uint64_t attempts) noexcept {
+        size_t bucket = attempts <= 1 ? 0 : std::bit_width(attempts - 1);
+        return bucket < HISTOGRAM_BUCKETS ? bucket : HISTOGRAM_BUCKETS - 1;
+    }
+
+    /// Average CAS attempts per operation (1.0 means no contention)
+    double average_attempts() const noexcept {
+        return operations ? static_cast<double>(attempts) / operations : 0.0;
+    }
+};
+
+/**
+ * @brief Snapshot of the CAS contention profile of an ObjectPool
+ *
+ * @details
+ * Only populated when the pool is compiled with SLICK_OBJECT_POOL_PROFILE_CAS.
+ * Sites:
+ * - CONSUME: consumer CAS claiming a slot (allocate() path)
+ *
+ * The producer side (free()) reserves ring indices with a single fetch_add
+ * and has no CAS to profile.
+ */
+struct CasProfile {
+    enum Site : uint32_t {
+        CONSUME = 0,
+        SITE_COUNT
+    };
+
+    CasSiteProfile sites[SITE_COUNT];
+
+    static constexpr const char* site_name(size_t site) noexcept {
+        switch (site) {
+        case CONSUME: return "consume";
+        default: return "unknown";
+        }
+    }
+
+    const CasSiteProfile& operator[](Site site) const noexcept {
+        return sites[site];
+    }
+};
+
+/**
+ * @brief Memory accounting of an ObjectPool
+ *
+ * @details
+ * - payload:  the pooled objects themselves (capacity * sizeof(T))
+ * - metadata: bookkeeping the pool needs: free list pointers, the used part
+ *             of each ring slot and the pool's own counters
+ * - padding:  bytes that carry no information: unused tail of each ring slot
+ *             and cache-line alignment inside the pool object
+ * - reserved: storage of a growable pool for objects not constructed yet;
+ *             allocated but not touched, so not resident until the pool grows
+ *
+ * total_bytes() excludes reserved bytes. Allocator chunk headers are not included.
+ */
+struct MemoryUsage {
+    uint64_t capacity = 0;          ///< Objects held by the pool
+    uint64_t payload_bytes = 0;     ///< Storage of the pooled objects
+    uint64_t metadata_bytes = 0;    ///< Free list, ring slots and counters
+    uint64_t padding_bytes = 0;     ///< Alignment and slot padding
+    uint64_t reserved_bytes = 0;    ///< Object storage reserved for growth (not in total_bytes())
+
+    constexpr uint64_t total_bytes() const noexcept {
+        return payload_bytes + metadata_bytes + padding_bytes;
+    }
+
+    /// Total bytes divided by capacity
+    constexpr double bytes_per_object() const noexcept {
+        return capacity ? static_cast<double>(total_bytes()) / capacity : 0.0;
+    }
+
+    /// Bytes per object beyond the object itself
+    constexpr double overhead_per_object() const noexcept {
+        return capacity ? static_cast<double>(metadata_bytes + padding_bytes) / capacity : 0.0;
+    }
+};
+
+/**
+ * @brief Usage profile of an ObjectPool, persisted between runs
+ *
+ * @details
+ * Records the demand a pool saw: the most objects outstanding at once
+ * (pooled plus heap fallbacks) and how many allocations fell back to the heap.
+ * Saved as a small key=value text file so it can be inspected and edited by
+ * hand; a pool constructed from a profile sizes itself to the recorded peak
+ * plus headroom (see ObjectPool::ObjectPool(const std::string&, uint32_t, double)).
+ *
+ * @par File format
+ * @code
+ * # slick_object_pool profile
+ * capacity=1024
+ * high_water_mark=1381
+ * fallbacks=412
+ * @endcode
+ */
+struct PoolProfile {
+    uint64_t capacity = 0;          ///< Capacity of the pool that recorded the profile
+    uint64_t high_water_mark = 0;   ///< Peak number of objects outstanding at once
+    uint64_t fallbacks = 0;         ///< Allocations served from the heap
+
+    /**
+     * @brief Capacity covering the recorded peak plus headroom
+     * @param headroom Fraction added on top of the peak (0.25 = 25%)
+     * @return Power of 2 capacity, at least 1
+     */
+    uint32_t recommended_capacity(double headroom) const noexcept {
+        double wanted = static_cast<double>(high_water_mark) * (1.0 + std::max(headroom, 0.0));
+        constexpr double limit = static_cast<double>(uint32_t(1) << 31);
+        if (wanted >= limit) {
+            return uint32_t(1) << 31;
+        }
+        auto needed = static_cast<uint32_t>(wanted);
+        needed += static_cast<double>(needed) < wanted ? 1 : 0;   // ceil
+        return std::bit_ceil(std::max<uint32_t>(needed, 1));
+    }
+
+    /**
+     * @brief Write the profile to a file
+     *
+     * @details
+     * Writes path + ".tmp" and renames it over path, so a crash or a full disk
+     * leaves the previous profile in place instead of a truncated one.
+     *
+     * @param path Profile file (replaced)
+     * @return false if the file could not be written
+     */
+    bool save(const std::string& path) const noexcept {
+        const std::string temp = path + ".tmp";
+        std::FILE* file = std::fopen(temp.c_str(), "w");
+        if (!file) {
+            return false;
+        }
+        int written = std::fprintf(file, "# slick_object_pool profile\ncapacity=%llu\nhigh_water_mark=%llu\nfallbacks=%llu\n",
+            static_cast<unsigned long long>(capacity), static_cast<unsigned long long>(high_water_mark),
+            static_cast<unsigned long long>(fallbacks));
+        std::error_code error;
+        if (std::fclose(file) != 0 || written <= 0) {
+            std::filesystem::remove(temp, error);
+            return false;
+        }
+        std::filesystem::rename(temp, path, error);
+        if (error) {
+            std::filesystem::remove(temp, error);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Read a profile written by save()
+     *
+     * @param path Profile file
+     * @param[out] profile Values read; keys missing from the file keep their value
+     * @return false if the file does not exist or has no high_water_mark
+     */
+    static bool load(const std::string& path, PoolProfile& profile) noexcept {
+        std::FILE* file = std::fopen(path.c_str(), "r");
+        if (!file) {
+            return false;
+        }
+        bool found = false;
+        char line[128];
+        unsigned long long value;
+        while (std::fgets(line, sizeof(line), file)) {
+            if (std::sscanf(line, "capacity=%llu", &value) == 1) {
+                profile.capacity = value;
+            } else if (std::sscanf(line, "high_water_mark=%llu", &value) == 1) {
+                profile.high_water_mark = value;
+                found = true;
+            } else if (std::sscanf(line, "fallbacks=%llu", &value) == 1) {
+                profile.fallbacks = value;
+            }
+        }
+        std::fclose(file);
+        return found;
+    }
+};
+
+/**
+ * @brief Types that clear their own state for reuse
+ *
+ * @details
+ * A Recyclable type provides `recycle()`, which should bring the object back
+ * to a reusable state while keeping what is expensive to rebuild, e.g.
+ * `std::vector::clear()` keeps the capacity.
+ */
+template<typename T>
+concept Recyclable = requires(T& obj) { obj.recycle(); };
+
+/**
+ * @brief Customization point resetting a pooled object for reuse
+ *
+ * @details
+ * The default calls `obj.recycle()` for Recyclable types. Otherwise
+ * trivially copyable, trivially default constructible types are zero-filled
+ * with memset, which the compiler turns into vector stores (the background
+ * scrubber also zeroes runs of adjacent objects in one call). Any other
+ * move-assignable type is assigned a value-initialized T. Types that are
+ * neither Recyclable nor assignable (e.g. holding a std::mutex or a const
+ * member) have no default recycle() and can only be pooled with
+ * RecycleMode::NONE. Specialize for types that need something else.
+ */
+template<typename T>
+struct recycler {
+    /// True when recycle() is a plain zero fill of the object's bytes
+    static constexpr bool zero_fill = !Recyclable<T> && std::is_trivially_copyable_v<T>
+        && std::is_trivially_default_constructible_v<T> && std::is_move_assignable_v<T>;
+
+    static void recycle(T& obj) requires (Recyclable<T> || std::is_move_assignable_v<T>) {
+        if constexpr (Recyclable<T>) {
+            obj.recycle();
+        } else if constexpr (zero_fill) {
+            std::memset(static_cast<void*>(&obj), 0, sizeof(T));
+        } else {
+            obj = T();
+        }
+    }
+};
+
+/**
+ * @brief Types recycler<T> can reset, by default or through a specialization
+ */
+template<typename T>
+concept PoolRecyclable = requires(T& obj) { recycler<T>::recycle(obj); };
+
+/**
+ * @brief Where an ObjectPool recycles freed objects
+ */
+enum class RecycleMode : uint8_t {
+    NONE,           ///< Objects keep their state across reuse (default)
+    ON_FREE,        ///< recycler<T>::recycle() runs inline in free()
+    ON_ALLOCATE,    ///< Deferred to the allocate() that hands the object out again
+    BACKGROUND,     ///< free() queues the object; scrub() recycles queued objects in batches
+};
+
 /**
  * @file object_pool.h
  * @brief Lock-free, cache-optimized object pool for high-performance allocation
@@ -31,21 +359,39 @@ namespace slick {
  * - O(1) allocation and deallocation
  * - Zero external dependencies (standard library only)
  * - Automatic heap allocation fallback when pool is exhausted
+ * - USDT static tracepoints (Linux) for perf/bpftrace
+ * - Optional CAS contention profiling (SLICK_OBJECT_POOL_PROFILE_CAS)
+ * - Opt-in allocation tracing for offline sizing (AllocationTrace)
+ * - High-water mark tracking and self-sizing from a persisted PoolProfile
+ * - Growth in segments, optionally ahead of time (PoolReplenisher)
+ * - Optional recycling of freed objects inline, on reuse or in the background (RecycleMode)
+ * - Runs of consecutive free objects stored as one ring entry (bulk free(), growth)
  *
  * @section memory_layout Memory Layout
  *
  * @code
- * [Cache Line 0: reserved_     Producer atomics (separate cache line)]
- * [Cache Line 1: consumed_     Consumer atomics (separate cache line)]
- * [Heap:         control_      Ring buffer metadata]
+ * [Cache Line 0: size_ ...     Read-mostly descriptor (never written on the hot path)]
+ * [Cache Line 1: ring_         Ring descriptor: slots, mask, lap shift (read-mostly)]
+ * [Cache Line 2: ring_         Producer counter (separate cache line)]
+ * [Cache Line 3: ring_         Consumer counter (separate cache line)]
+ * [Cache Line 4: high_water_mark_ ...  Demand tracking, written off the fast path]
+ * [Heap:         ring slots    Lap tag + object run, 8 bytes each (see detail::PoolRing)]
  * [Heap:         buffer_       Pooled objects]
- * [Heap:         free_objects_ Free object pointers]
  * @endcode
  *
  * @section thread_safety Thread Safety
  * - Multiple threads can call allocate() concurrently (lock-free)
  * - Multiple threads can call free() concurrently (lock-free)
- * - reset() is NOT thread-safe
+ * - reset() may run concurrently with allocate(), not with free() (see reset())
+ *
+ * @section tracing USDT Probes
+ * Provider `slick_object_pool`, every probe takes (pool address, value):
+ * - `allocate`          (pool, object) - object handed out from the pool
+ * - `allocate_fallback` (pool, object) - pool exhausted, object allocated from heap
+ * - `free`              (pool, object) - object returned to the pool
+ * - `free_heap`         (pool, object) - heap-allocated object deleted
+ * - `free_range`        (pool, count) - consecutive objects returned by one bulk free()
+ * - `consume_retry`     (pool, attempt) - consumer CAS failed in consume()
  *
  * @section example Example Usage
  * @code
@@ -75,38 +421,71 @@ class ObjectPool {
     static constexpr size_t CACHE_LINE_SIZE = 64;
 #endif
 
-    /**
-     * @brief Ring buffer slot metadata
-     * @details Tracks the data index and size for each slot in the ring buffer
-     */
-    struct slot {
-        std::atomic_uint_fast64_t data_index{ std::numeric_limits<uint64_t>::max() };  ///< Absolute index of data in this slot
-        uint32_t size = 1;  ///< Number of consecutive slots occupied
-    };
+    using profile_clock = std::chrono::steady_clock;
 
+#ifdef SLICK_OBJECT_POOL_PROFILE_CAS
     /**
-     * @brief Producer reservation information
-     * @details Tracks the current write position and reservation size
+     * @brief Live counters of one CAS call site
+     * @details One cache line per site so profiling does not add false sharing between sites
      */
-    struct reserved_info {
-        uint_fast64_t index_ = 0;  ///< Next available write index
-        uint_fast32_t size_ = 0;   ///< Size of current reservation
+    struct alignas(CACHE_LINE_SIZE) cas_site_counters {
+        std::atomic_uint_fast64_t operations{ 0 };
+        std::atomic_uint_fast64_t attempts{ 0 };
+        std::atomic_uint_fast64_t retry_ns{ 0 };
+        std::atomic_uint_fast64_t histogram[CasSiteProfile::HISTOGRAM_BUCKETS] = {};
     };
 
-    // Cache-line aligned atomics to prevent false sharing
-    alignas(CACHE_LINE_SIZE) std::atomic<reserved_info> reserved_;  ///< Producer reservation counter (own cache line)
-    alignas(CACHE_LINE_SIZE) std::atomic_uint_fast64_t consumed_;   ///< Consumer consumption counter (own cache line)
+    cas_site_counters cas_sites_[CasProfile::SITE_COUNT];  ///< CAS contention counters per call site
+#endif
 
-    // Object storage
-    uint32_t size_;                 ///< Pool capacity (must be power of 2)
-    uint32_t mask_;                 ///< Bitmask for index wrapping (size_ - 1)
-    T* buffer_ = nullptr;           ///< Array of pooled objects
+    // Read-mostly descriptor: every allocate() and free() reads it, nothing on
+    // the hot path writes it. Its own cache line keeps it Shared in every
+    // core's cache instead of being invalidated by the CAS traffic below.
+    alignas(CACHE_LINE_SIZE) uint32_t size_;    ///< Ring size = maximum capacity (must be power of 2)
+    RecycleMode recycle_mode_ = RecycleMode::NONE;  ///< Where freed objects are recycled
+    bool track_demand_ = false;     ///< Update the high-water mark on every allocate(), not only on heap fallback
+    T* buffer_ = nullptr;           ///< Storage for size_ objects, constructed up to constructed_
     intptr_t lower_bound_ = 0;      ///< Lower address bound for pool ownership check
     intptr_t upper_bound_ = 0;      ///< Upper address bound for pool ownership check
-    T** free_objects_ = nullptr;    ///< Array of pointers to free objects
-    slot* control_ = nullptr;       ///< Ring buffer control slots
+    std::atomic<AllocationTrace*> trace_{ nullptr };  ///< Attached allocation trace (nullptr = not tracing)
+
+    // Free object indices: the ring's own descriptor line, then its producer
+    // and consumer counters on separate cache lines
+    detail::PoolRing ring_;         ///< Ring of free objects, initial fill [0, capacity)
+
+    // Demand tracking, written on heap fallbacks and by opt-in high-water
+    // tracking. Its own cache line keeps those writes from invalidating the
+    // consumer counter every allocate() CASes.
+    alignas(CACHE_LINE_SIZE) std::atomic_uint_fast64_t high_water_mark_{ 0 };    ///< Peak objects outstanding (pooled + heap)
+    std::atomic_uint_fast64_t heap_live_{ 0 };          ///< Heap fallback objects not yet freed
+    std::atomic_uint_fast64_t fallbacks_{ 0 };          ///< Allocations served from the heap
+
+    std::atomic_uint32_t capacity_{ 0 };  ///< Objects published to the ring (current capacity)
+    uint32_t segment_size_ = 0;     ///< Objects added when allocate() grows the pool (0 = no inline growth)
+    std::string profile_path_;      ///< Profile saved on destruction (empty = none)
+
+    // Growth (off the hot path)
+    std::mutex grow_mutex_;         ///< Serializes grow(), stage(), trim_staged(), scrub() and reset()
+    uint32_t constructed_ = 0;      ///< Objects constructed in buffer_ (capacity + staged), guarded by grow_mutex_
+    std::atomic_uint32_t staged_{ 0 };  ///< Constructed objects not yet published
+
+    // Recycling
+    static constexpr uint32_t NO_OBJECT = std::numeric_limits<uint32_t>::max();
+    uint32_t* dirty_next_ = nullptr;    ///< BACKGROUND: next link of each queued object, by object index
+    alignas(CACHE_LINE_SIZE) std::atomic_uint32_t dirty_head_{ NO_OBJECT };  ///< BACKGROUND: last queued object
+    std::atomic_uint32_t dirty_count_{ 0 };  ///< BACKGROUND: objects waiting for scrub()
 
 public:
+    /// Returned by index_of() for objects the pool does not own
+    static constexpr uint32_t npos = NO_OBJECT;
+
+    /// True when the pool is compiled with CAS contention profiling
+#ifdef SLICK_OBJECT_POOL_PROFILE_CAS
+    static constexpr bool cas_profiling_enabled = true;
+#else
+    static constexpr bool cas_profiling_enabled = false;
+#endif
+
     /**
      * @brief Construct a new object pool
      *
@@ -127,38 +506,116 @@ public:
      * @endcode
      */
     ObjectPool(uint32_t size)
-        : size_(size)
-        , mask_(size - 1)
-        , buffer_(new T[size_])
-        , free_objects_(new T*[size_])
-        , control_(new slot[size_])
+        : ObjectPool(size, size, 0)
+    {
+    }
+
+    /**
+     * @brief Construct a growable object pool
+     *
+     * @details
+     * Starts with `size` objects and can grow up to `max_size`. Storage for
+     * max_size objects and the ring metadata are allocated up front, so
+     * growing never moves objects and the ownership check stays a single
+     * address range. Objects are only constructed when the pool grows; on
+     * Linux, pages of storage never constructed stay uncommitted.
+     *
+     * The pool grows by `segment_size` objects when allocate() finds it empty,
+     * or ahead of time through grow()/stage(), e.g. from a PoolReplenisher.
+     *
+     * @param size Initial capacity (must be power of 2)
+     * @param max_size Maximum capacity (must be power of 2, >= size)
+     * @param segment_size Objects added by allocate() on exhaustion (0 = fall back to heap instead)
+     *
+     * @par Example
+     * @code
+     * // 1024 objects now, grows by 1024 on exhaustion up to 16384
+     * slick::ObjectPool<MyStruct> pool(1024, 16384, 1024);
+     * @endcode
+     */
+    ObjectPool(uint32_t size, uint32_t max_size, uint32_t segment_size)
+        : size_(max_size)
+        , ring_(max_size, size)
+        , segment_size_(segment_size)
     {
         assert((size && !(size & (size - 1))) && "size must be power of 2");
+        assert((max_size && !(max_size & (max_size - 1))) && "max_size must be power of 2");
+        assert(size <= max_size && "size must not exceed max_size");
+
+        buffer_ = static_cast<T*>(::operator new(sizeof(T) * size_t(max_size), std::align_val_t(alignof(T))));
 
-        // Initialize pool with all objects available
-        uint64_t index;
-        for (uint32_t i = 0; i < size_; ++i) {
-            index = reserve();
-            free_objects_[index & mask_] = &buffer_[i];
-            publish(index);
+        // Initialize pool with all objects available (the ring's initial fill)
+        try {
+            for (; constructed_ < size; ++constructed_) {
+                new (&buffer_[constructed_]) T;
+            }
+        } catch (...) {
+            // The destructor does not run for a throwing constructor
+            release_buffer();
+            throw;
         }
+        capacity_.store(size, std::memory_order_relaxed);
 
         lower_bound_ = reinterpret_cast<intptr_t>(&buffer_[0]);
-        upper_bound_ = reinterpret_cast<intptr_t>(&buffer_[mask_]);
+        upper_bound_ = reinterpret_cast<intptr_t>(&buffer_[size_ - 1]);
+    }
+
+    /**
+     * @brief Construct a pool sized from a persisted usage profile
+     *
+     * @details
+     * Reads the profile at profile_path and sizes the pool to the recorded
+     * high-water mark plus headroom, rounded up to a power of 2. Without a
+     * profile the pool gets default_size. The pool tracks its high-water mark
+     * on every allocation (see track_high_water_mark()) and writes its own
+     * profile back to the same path when it is destroyed, so across restarts
+     * the capacity converges to the observed demand, in both directions.
+     *
+     * @param profile_path Profile file read now and written on destruction
+     * @param default_size Capacity when no profile exists (must be power of 2)
+     * @param headroom Fraction added on top of the recorded peak
+     *
+     * @par Example
+     * @code
+     * // Nightly restart: starts at 4096, then follows yesterday's peak + 25%
+     * slick::ObjectPool<Order> orders("/var/lib/app/orders.profile", 4096);
+     * @endcode
+     */
+    ObjectPool(const std::string& profile_path, uint32_t default_size, double headroom = 0.25)
+        : ObjectPool(tuned_capacity(profile_path, default_size, headroom))
+    {
+        profile_path_ = profile_path;
+        track_demand_ = true;
+    }
+
+    /**
+     * @brief Capacity a profile-sized pool would get
+     *
+     * @param profile_path Profile file
+     * @param default_size Capacity when no profile exists
+     * @param headroom Fraction added on top of the recorded peak
+     * @return Recommended capacity, or default_size without a profile
+     */
+    static uint32_t tuned_capacity(const std::string& profile_path, uint32_t default_size, double headroom = 0.25) noexcept {
+        PoolProfile profile;
+        return PoolProfile::load(profile_path, profile) ? profile.recommended_capacity(headroom) : default_size;
     }
 
     /**
      * @brief Destructor - cleans up all resources
+     *
+     * @details
+     * A pool constructed from a profile saves its usage profile first.
      */
     virtual ~ObjectPool() noexcept {
-        delete[] buffer_;
-        buffer_ = nullptr;
+        if (!profile_path_.empty()) {
+            save_profile(profile_path_);
+        }
 
-        delete[] free_objects_;
-        free_objects_ = nullptr;
+        release_buffer();
 
-        delete[] control_;
-        control_ = nullptr;
+        delete[] dirty_next_;
+        dirty_next_ = nullptr;
     }
 
     // Delete copy and move operations
@@ -169,12 +626,164 @@ public:
 
     /**
      * @brief Get pool capacity
-     * @return Maximum number of objects the pool can hold
+     * @return Number of objects the pool currently holds (grows up to max_size())
      */
     uint32_t size() const noexcept {
+        return capacity_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the capacity the pool can grow to
+     * @return Maximum capacity (size() for pools that cannot grow)
+     */
+    uint32_t max_size() const noexcept {
         return size_;
     }
 
+    /**
+     * @brief Approximate number of objects ready to be allocated
+     * @details
+     * Derived from the ring counters; exact only while no other thread runs.
+     * Objects waiting for scrub() are not counted.
+     */
+    uint32_t available() const noexcept {
+        auto unavailable = outstanding() + (recycle_mode_ == RecycleMode::BACKGROUND ? dirty() : 0);
+        return static_cast<uint32_t>(size() - std::min<uint64_t>(unavailable, size()));
+    }
+
+    /**
+     * @brief Number of constructed objects waiting to be published by grow()
+     */
+    uint32_t staged() const noexcept {
+        return staged_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Add objects to the pool
+     *
+     * @details
+     * Publishes up to n objects: staged (pre-constructed) objects first, then
+     * newly constructed ones, limited by max_size(). All of them become
+     * visible to allocate() through one bulk publish. Thread-safe; concurrent
+     * growers are serialized, allocate() and free() are not blocked.
+     *
+     * @param n Objects to add
+     * @return Objects added (0 when the pool is at max_size())
+     */
+    uint32_t grow(uint32_t n) {
+        std::lock_guard lock(grow_mutex_);
+        return grow_locked(n);
+    }
+
+    /**
+     * @brief Construct objects ahead of time without publishing them
+     *
+     * @details
+     * Staged objects are published by the next grow(), which then costs no
+     * construction. Use it to move expensive T constructors off the hot path.
+     *
+     * @param n Objects to construct
+     * @return Objects constructed (limited by max_size())
+     */
+    uint32_t stage(uint32_t n) {
+        std::lock_guard lock(grow_mutex_);
+        auto count = std::min<uint32_t>(n, size_ - constructed_);
+        for (uint32_t i = 0; i < count; ++i, ++constructed_) {
+            new (&buffer_[constructed_]) T;
+        }
+        staged_.fetch_add(count, std::memory_order_relaxed);
+        return count;
+    }
+
+    /**
+     * @brief Destroy staged objects
+     *
+     * @details
+     * Published objects cannot be taken back out of the ring, so trimming is
+     * limited to objects staged but not yet published.
+     *
+     * @return Objects destroyed
+     */
+    uint32_t trim_staged() noexcept {
+        std::lock_guard lock(grow_mutex_);
+        auto count = staged_.load(std::memory_order_relaxed);
+        for (uint32_t i = 0; i < count; ++i) {
+            buffer_[--constructed_].~T();
+        }
+        staged_.store(0, std::memory_order_relaxed);
+        return count;
+    }
+
+    /**
+     * @brief Memory a pool of the given capacity occupies
+     *
+     * @details
+     * Counts the pool object itself and its two arrays: objects and ring
+     * slots. Usable at compile time to budget pools before
+     * creating them.
+     *
+     * @param capacity Pool capacity
+     * @return Payload, metadata and padding bytes
+     *
+     * @par Example
+     * @code
+     * constexpr auto usage = slick::ObjectPool<Order>::footprint(1 << 20);
+     * static_assert(usage.total_bytes() < (256ull << 20));
+     * @endcode
+     */
+    static constexpr MemoryUsage footprint(uint32_t capacity) noexcept {
+        return footprint(capacity, capacity);
+    }
+
+    /**
+     * @brief Memory a growable pool occupies at a given capacity
+     *
+     * @details
+     * Ring metadata is sized for max_capacity. Storage of objects beyond
+     * capacity is reported in reserved_bytes.
+     *
+     * @param capacity Constructed objects
+     * @param max_capacity Maximum capacity
+     * @return Payload, metadata, padding and reserved bytes
+     */
+    static constexpr MemoryUsage footprint(uint32_t capacity, uint32_t max_capacity) noexcept {
+        constexpr uint64_t state_used = detail::PoolRing::state_bytes()
+            + sizeof(size_) + sizeof(buffer_) + sizeof(lower_bound_) + sizeof(upper_bound_)
+            + sizeof(trace_) + sizeof(high_water_mark_) + sizeof(heap_live_) + sizeof(fallbacks_)
+            + sizeof(profile_path_) + sizeof(capacity_) + sizeof(segment_size_) + sizeof(grow_mutex_)
+            + sizeof(constructed_) + sizeof(staged_) + sizeof(recycle_mode_) + sizeof(track_demand_) + sizeof(dirty_next_)
+            + sizeof(dirty_head_) + sizeof(dirty_count_) + sizeof(void*)     // vtable pointer
+#ifdef SLICK_OBJECT_POOL_PROFILE_CAS
+            + sizeof(std::atomic_uint_fast64_t) * (3 + CasSiteProfile::HISTOGRAM_BUCKETS) * CasProfile::SITE_COUNT
+#endif
+            ;
+
+        MemoryUsage usage;
+        usage.capacity = capacity;
+        usage.payload_bytes = uint64_t(capacity) * sizeof(T);
+        usage.metadata_bytes = uint64_t(max_capacity) * sizeof(detail::PoolRing::slot) + state_used;
+        usage.padding_bytes = sizeof(ObjectPool) - state_used;
+        usage.reserved_bytes = uint64_t(max_capacity - capacity) * sizeof(T);
+        return usage;
+    }
+
+    /**
+     * @brief Memory this pool occupies
+     *
+     * @details
+     * Objects handed out from the heap fallback are not owned by the pool and
+     * are not counted.
+     *
+     * @return Payload, metadata and padding bytes
+     */
+    MemoryUsage memory_usage() const noexcept {
+        auto usage = footprint(size() + staged(), size_);
+        if (dirty_next_) {
+            usage.metadata_bytes += uint64_t(size_) * sizeof(uint32_t);
+        }
+        return usage;
+    }
+
     /**
      * @brief Allocate an object from the pool
      *
@@ -198,12 +807,36 @@ public:
      * @endcode
      */
     T* allocate() {
-        auto [obj, size] = consume();
+        T* obj = consume();
+        if (!obj && segment_size_) [[unlikely]] {
+            // Pool exhausted - grow unless another thread is already growing it
+            std::unique_lock lock(grow_mutex_, std::try_to_lock);
+            if (lock.owns_lock() && grow_locked(segment_size_)) {
+                lock.unlock();
+                obj = consume();
+            }
+        }
         if (!obj) {
             // Pool exhausted - allocate from heap
-            return new T();
+            obj = new T();
+            fallbacks_.fetch_add(1, std::memory_order_relaxed);
+            update_high_water_mark(this->size() + heap_live_.fetch_add(1, std::memory_order_relaxed) + 1);
+            SLICK_OBJECT_POOL_PROBE(allocate_fallback, reinterpret_cast<uintptr_t>(this), reinterpret_cast<uintptr_t>(obj));
+            if (auto* trace = trace_.load(std::memory_order_relaxed)) [[unlikely]] {
+                trace->record(AllocationTrace::ALLOCATE_HEAP, AllocationTrace::heap_object_id(obj));
+            }
+            return obj;
+        }
+        if (recycle_mode_ == RecycleMode::ON_ALLOCATE) {
+            recycle(*obj);
+        }
+        if (track_demand_) {
+            update_high_water_mark(outstanding() + heap_live_.load(std::memory_order_relaxed));
+        }
+        SLICK_OBJECT_POOL_PROBE(allocate, reinterpret_cast<uintptr_t>(this), reinterpret_cast<uintptr_t>(obj));
+        if (auto* trace = trace_.load(std::memory_order_relaxed)) [[unlikely]] {
+            trace->record(AllocationTrace::ALLOCATE, static_cast<uint32_t>(obj - buffer_));
         }
-        assert(size == 1);
         return obj;
     }
 
@@ -234,188 +867,536 @@ public:
      */
     void free(T* obj) {
         auto o = reinterpret_cast<intptr_t>(obj);
+        auto* trace = trace_.load(std::memory_order_relaxed);
         if (o >= lower_bound_ && o <= upper_bound_) {
             // Object belongs to pool - return it
-            auto index = reserve();
-            free_objects_[index & mask_] = obj;
-            publish(index);
+            SLICK_OBJECT_POOL_PROBE(free, reinterpret_cast<uintptr_t>(this), o);
+            if (trace) [[unlikely]] {
+                trace->record(AllocationTrace::FREE, static_cast<uint32_t>(obj - buffer_));
+            }
+            if (recycle_mode_ != RecycleMode::NONE) [[unlikely]] {
+                if (recycle_mode_ == RecycleMode::BACKGROUND) {
+                    push_dirty(static_cast<uint32_t>(obj - buffer_));
+                    return;
+                }
+                if (recycle_mode_ == RecycleMode::ON_FREE) {
+                    recycle(*obj);
+                }
+            }
+            ring_.publish(ring_.reserve(), static_cast<uint32_t>(obj - buffer_));
         } else {
             // Object was heap-allocated - delete it
+            SLICK_OBJECT_POOL_PROBE(free_heap, reinterpret_cast<uintptr_t>(this), o);
+            heap_live_.fetch_sub(1, std::memory_order_relaxed);
+            if (trace) [[unlikely]] {
+                trace->record(AllocationTrace::FREE_HEAP, AllocationTrace::heap_object_id(obj));
+            }
             delete obj;
         }
     }
 
     /**
-     * @brief Reset the pool to initial state
+     * @brief Return count consecutive pool objects, first[0] to first[count - 1]
      *
      * @details
-     * Reinitializes the pool, making all objects available again.
-     * This is primarily intended for testing and should be used with caution.
+     * Without recycling (or with ON_FREE / ON_ALLOCATE) the range takes one
+     * ring reservation and one slot per run of up to 2^(32 - log2(max_size()))
+     * objects instead of one of each per object; allocate() splits the run
+     * again as it hands the objects out. In BACKGROUND mode every object is
+     * queued for scrub() as by free(T*).
      *
-     * @warning NOT THREAD-SAFE
-     * @warning Must be called when NO other threads are accessing the pool
-     * @warning Invalidates all outstanding object references
+     * @param first First object of the range
+     * @param count Number of objects
      *
-     * @par Use Cases
-     * - Unit testing: Reset pool state between tests
-     * - Application reset: Clear all allocations during shutdown
+     * @par Thread Safety
+     * Safe to call concurrently from multiple threads
      *
-     * @note Do not use in production with concurrent access
+     * @warning Every object of the range must come from the pool, not from
+     *          the heap fallback, and must not be freed twice
      */
-    void reset() noexcept {
-        delete[] control_;
-        control_ = new slot[size_];
+    void free(T* first, uint32_t count) {
+        assert(count == 0 || (first >= buffer_ && first + count <= buffer_ + size()));
+        const auto index = static_cast<uint32_t>(first - buffer_);
+        SLICK_OBJECT_POOL_PROBE(free_range, reinterpret_cast<uintptr_t>(this), count);
+        if (auto* trace = trace_.load(std::memory_order_relaxed)) [[unlikely]] {
+            for (uint32_t i = 0; i < count; ++i) {
+                trace->record(AllocationTrace::FREE, index + i);
+            }
+        }
+        if (recycle_mode_ != RecycleMode::NONE) [[unlikely]] {
+            if (recycle_mode_ == RecycleMode::BACKGROUND) {
+                for (uint32_t i = 0; i < count; ++i) {
+                    push_dirty(index + i);
+                }
+                return;
+            }
+            if (recycle_mode_ == RecycleMode::ON_FREE) {
+                for (uint32_t i = 0; i < count; ++i) {
+                    recycle(first[i]);
+                }
+            }
+        }
+        ring_.publish_range(index, count);
+    }
 
-        reserved_.store(reserved_info(), std::memory_order_release);
-        uint64_t index;
-        for (uint32_t i = 0; i < size_; ++i) {
-            index = reserve();
-            free_objects_[index & mask_] = &buffer_[i];
-            publish(index);
+    /**
+     * @brief Choose where freed objects are recycled
+     *
+     * @details
+     * - ON_FREE runs recycler<T>::recycle() inside free()
+     * - ON_ALLOCATE runs it in the allocate() that reuses the object, so
+     *   free() stays as cheap as with NONE
+     * - BACKGROUND makes free() push the object onto a lock-free queue;
+     *   scrub() (e.g. from a PoolScrubber thread) recycles queued objects in
+     *   batches and republishes them. Queued objects are not available to
+     *   allocate() until scrubbed.
+     *
+     * Heap fallback objects are deleted on free and never recycled.
+     *
+     * @param mode Recycling mode
+     * @throws std::runtime_error if mode is not NONE and T is not PoolRecyclable
+     *
+     * @warning Set before the pool is shared between threads. When leaving
+     *          BACKGROUND, call scrub() to return queued objects.
+     */
+    void recycle_mode(RecycleMode mode) {
+        if constexpr (!PoolRecyclable<T>) {
+            if (mode != RecycleMode::NONE) {
+                throw std::runtime_error("recycling needs a Recyclable or assignable type, or a recycler specialization");
+            }
+        }
+        if (mode == RecycleMode::BACKGROUND && !dirty_next_) {
+            dirty_next_ = new uint32_t[size_];
         }
-        consumed_.store(0, std::memory_order_release);
+        recycle_mode_ = mode;
     }
 
-private:
     /**
-     * @brief Get the initial reading index
-     * @return Starting index for consumption
+     * @brief Current recycling mode
      */
-    uint64_t get_read_index() const noexcept {
-        return consumed_.load(std::memory_order_acquire);
+    RecycleMode recycle_mode() const noexcept {
+        return recycle_mode_;
     }
 
     /**
-     * @brief Reserve space in the ring buffer for writing
+     * @brief Number of freed objects waiting for scrub()
+     */
+    uint32_t dirty() const noexcept {
+        return dirty_count_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Recycle queued objects and return them to the pool
      *
      * @details
-     * Atomically reserves n slots in the ring buffer using compare-and-swap.
-     * Handles ring buffer wrapping when reaching the end.
-     *
-     * @param n Number of slots to reserve (default: 1)
-     * @return Starting index of the reserved space
-     *
-     * @throws std::runtime_error If n exceeds pool size
+     * Takes every object queued by free() in BACKGROUND mode, recycles it and
+     * publishes it back in batches of up to `batch` objects. For zero-filled
+     * types the objects of a batch are sorted by address and adjacent objects
+     * are cleared with a single memset. Safe to call from several threads;
+     * calls are serialized with each other and with reset().
      *
-     * @note Lock-free operation using CAS
-     * @note May retry multiple times under high contention
+     * @param batch Objects recycled and published together
+     * @return Objects returned to the pool
      */
-    uint64_t reserve(uint32_t n = 1) {
-        if (n > size_) [[unlikely]] {
-            throw std::runtime_error("required size " + std::to_string(n) + " > pool size " + std::to_string(size_));
+    uint32_t scrub(uint32_t batch = 256) {
+        if (dirty_head_.load(std::memory_order_relaxed) == NO_OBJECT) {
+            return 0;
         }
-        auto reserved = reserved_.load(std::memory_order_relaxed);
-        reserved_info next;
-        uint64_t index;
-        bool buffer_wrapped = false;
-        do {
-            buffer_wrapped = false;
-            next = reserved;
-            index = reserved.index_;
-            auto idx = index & mask_;
-            if ((idx + n) > size_) {
-                // Not enough buffer left, wrap to beginning
-                index += size_ - idx;
-                next.index_ = index + n;
-                next.size_ = n;
-                buffer_wrapped = true;
-            }
-            else {
-                next.index_ += n;
-                next.size_ = n;
+        std::lock_guard lock(grow_mutex_);
+        auto head = dirty_head_.exchange(NO_OBJECT, std::memory_order_acquire);
+        if (head == NO_OBJECT) {
+            return 0;
+        }
+        constexpr uint32_t MAX_BATCH = 1024;
+        batch = std::clamp<uint32_t>(batch, 1, MAX_BATCH);
+        uint32_t indices[MAX_BATCH];
+        uint32_t total = 0;
+        while (head != NO_OBJECT) {
+            uint32_t n = 0;
+            for (; n < batch && head != NO_OBJECT; ++n) {
+                indices[n] = head;
+                head = dirty_next_[head];
             }
-        } while(!reserved_.compare_exchange_weak(reserved, next, std::memory_order_release, std::memory_order_relaxed));
-
-        if (buffer_wrapped) {
-            // queue wrapped, set current slock.data_index to the reserved index to let the reader
-            // know the next available data is in different slot.
-            auto& slot = control_[reserved.index_ & mask_];
-            slot.size = n;
-            slot.data_index.store(index, std::memory_order_release);
+            recycle_batch(indices, n);
+            ring_.publish_indices(indices, n);
+            total += n;
         }
-        return index;
+        dirty_count_.fetch_sub(total, std::memory_order_relaxed);
+        return total;
+    }
+
+    /**
+     * @brief Usage profile recorded since construction (or reset_profile())
+     *
+     * @details
+     * The high-water mark counts pooled objects outstanding plus live heap
+     * fallbacks, so it measures demand even when the pool was too small.
+     * Unless tracking is on (see track_high_water_mark()), it is only updated
+     * when allocate() falls back to the heap, i.e. it records peaks beyond
+     * the pool's size but not below it. Values are read with relaxed ordering.
+     *
+     * @return Capacity, high-water mark and fallback count
+     */
+    PoolProfile profile() const noexcept {
+        PoolProfile profile;
+        profile.capacity = size_;
+        profile.high_water_mark = high_water_mark_.load(std::memory_order_relaxed);
+        profile.fallbacks = fallbacks_.load(std::memory_order_relaxed);
+        return profile;
+    }
+
+    /**
+     * @brief Write profile() to a file
+     * @param path Profile file (replaced)
+     * @return false if the file could not be written
+     */
+    bool save_profile(const std::string& path) const noexcept {
+        return profile().save(path);
+    }
+
+    /**
+     * @brief Restart high-water mark and fallback tracking
+     * @details The high-water mark restarts from the current number of outstanding objects.
+     */
+    void reset_profile() noexcept {
+        fallbacks_.store(0, std::memory_order_relaxed);
+        high_water_mark_.store(outstanding() + heap_live_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Update the high-water mark on every allocate()
+     *
+     * @details
+     * Off by default: counting outstanding objects reads both ring counters
+     * and the shared demand counters, which every allocate() would pay for.
+     * Without it the high-water mark only moves when the pool is exhausted.
+     * Pools constructed from a profile turn it on.
+     *
+     * @param enable Track on every allocate()
+     *
+     * @warning Set before the pool is shared between threads.
+     */
+    void track_high_water_mark(bool enable) noexcept {
+        track_demand_ = enable;
+    }
+
+    /**
+     * @brief Whether allocate() updates the high-water mark every time
+     */
+    bool tracks_high_water_mark() const noexcept {
+        return track_demand_;
+    }
+
+    /**
+     * @brief Check whether an object lives in the pool's storage
+     *
+     * @param obj Object pointer
+     * @return true if obj is a pool slot, false if it came from the heap fallback
+     */
+    bool owns(const T* obj) const noexcept {
+        auto o = reinterpret_cast<intptr_t>(obj);
+        return o >= lower_bound_ && o <= upper_bound_;
     }
 
     /**
-     * @brief Access reserved space for writing
-     * @param index Index returned by reserve()
-     * @return Pointer to array position
+     * @brief Index of a pool object in the pool's storage
+     *
+     * @details
+     * Indices are stable for the lifetime of the pool and fit in 32 bits, so
+     * they can replace pointers as links between pooled objects (see
+     * pool_containers.h).
+     *
+     * @param obj Object pointer
+     * @return Index in [0, max_size()), or npos for heap fallback objects
      */
-    T** operator[] (uint64_t index) noexcept {
-        return &free_objects_[index & mask_];
+    uint32_t index_of(const T* obj) const noexcept {
+        return owns(obj) ? static_cast<uint32_t>(obj - buffer_) : npos;
     }
 
     /**
-     * @brief Access reserved space for writing (const version)
-     * @param index Index returned by reserve()
-     * @return Const pointer to array position
+     * @brief Object at an index returned by index_of()
      */
-    const T** operator[] (uint64_t index) const noexcept {
-        return &free_objects_[index & mask_];
+    T& object_at(uint32_t index) noexcept {
+        assert(index < size_);
+        return buffer_[index];
+    }
+
+    /// @copydoc object_at()
+    const T& object_at(uint32_t index) const noexcept {
+        assert(index < size_);
+        return buffer_[index];
     }
 
     /**
-     * @brief Publish data written to reserved space
+     * @brief Attach or detach an allocation trace
      *
      * @details
-     * Makes previously reserved and written data visible to consumers.
-     * Must be called after writing to reserved space.
+     * While attached, every allocate() and free() is recorded in the trace
+     * (pool index for pooled objects, AllocationTrace::heap_object_id() for
+     * heap fallbacks). Tracing costs one relaxed load per call when detached.
+     *
+     * @param trace Trace to record into, or nullptr to stop tracing
      *
-     * @param index Index returned by reserve()
-     * @param n Number of slots to publish (default: 1)
+     * @note The trace must outlive its attachment; detach before closing it
      *
-     * @note Uses release memory ordering for synchronization
+     * @par Example
+     * @code
+     * slick::AllocationTrace trace("pool.trace");
+     * pool.trace(&trace);
+     * run_session();
+     * pool.trace(nullptr);
+     * trace.close();
+     * @endcode
      */
-    void publish(uint64_t index, uint32_t n = 1) noexcept {
-        auto& slot = control_[index & mask_];
-        slot.size = n;
-        slot.data_index.store(index, std::memory_order_release);
+    void trace(AllocationTrace* trace) noexcept {
+        if (trace) {
+            trace->attach(size_, static_cast<uint32_t>(sizeof(T)));
+        }
+        trace_.store(trace, std::memory_order_release);
     }
 
     /**
-     * @brief Consume data from the ring buffer
+     * @brief Reset the pool to initial state
      *
      * @details
-     * Atomically retrieves the next available object from the pool.
-     * Returns {nullptr, 0} if no objects are currently available.
-     *
-     * @return Pair of {object_pointer, slot_count}
-     *         Returns {nullptr, 0} if pool is empty
-     *
-     * @note Lock-free operation using CAS
-     * @note May retry multiple times under high contention
-     */
-    std::pair<T*, uint32_t> consume() noexcept {
-        while (true) {
-            uint64_t current_index = consumed_.load(std::memory_order_acquire);
-            auto current = current_index & mask_;
-            slot* current_slot = &control_[current];
-            uint64_t stored_index = current_slot->data_index.load(std::memory_order_acquire);
-
-            if (stored_index != std::numeric_limits<uint64_t>::max() && reserved_.load(std::memory_order_relaxed).index_ < stored_index) [[unlikely]] {
-                // queue has been reset
-                consumed_.store(0, std::memory_order_release);
-                continue;
+     * Makes all objects available again in O(1), without touching the ring.
+     * The counters jump to a new generation that starts on a fresh lap past
+     * every index reserved so far, so every slot written before becomes stale
+     * through its lap tag, and the new generation's initial fill covers all
+     * objects (see detail::PoolRing::reset()).
+     *
+     * Never blocks allocate() or free() and leaves the ring consistent. An
+     * allocate() running concurrently with reset() may return an object of
+     * either generation; treat it as allocated before the reset.
+     *
+     * @warning Invalidates all outstanding object references; objects
+     *          allocated before reset() must not be freed after it
+     * @warning free() must not overlap reset(). A free() that reserves its
+     *          ring index after the reset started publishes its object into
+     *          the new generation, whose initial fill already holds it, so
+     *          the object is handed out twice. One that reserved its index
+     *          before the reset is discarded, but the caller cannot tell
+     *          which of the two it hit.
+     *
+     * @par Use Cases
+     * - Unit testing: Reset pool state between tests
+     * - Per-session or per-frame pools: release everything at once
+     */
+    void reset() noexcept {
+        std::lock_guard lock(grow_mutex_);
+        const uint32_t fill = capacity_.load(std::memory_order_relaxed);
+        dirty_head_.store(NO_OBJECT, std::memory_order_relaxed);
+        dirty_count_.store(0, std::memory_order_relaxed);
+        ring_.reset(fill);
+    }
+
+    /**
+     * @brief Take a snapshot of the CAS contention profile
+     *
+     * @details
+     * Counters are read with relaxed ordering, so a snapshot taken while other
+     * threads are running is approximate but never torn per counter.
+     * Returns an empty profile unless compiled with SLICK_OBJECT_POOL_PROFILE_CAS.
+     *
+     * @return Per-site attempt histograms and retry time
+     *
+     * @par Example
+     * @code
+     * auto profile = pool.cas_profile();
+     * auto& consume = profile[slick::CasProfile::CONSUME];
+     * std::cout << consume.average_attempts() << " attempts/op\n";
+     * @endcode
+     */
+    CasProfile cas_profile() const noexcept {
+        CasProfile profile;
+#ifdef SLICK_OBJECT_POOL_PROFILE_CAS
+        for (size_t i = 0; i < CasProfile::SITE_COUNT; ++i) {
+            auto& counters = cas_sites_[i];
+            auto& site = profile.sites[i];
+            site.operations = counters.operations.load(std::memory_order_relaxed);
+            site.attempts = counters.attempts.load(std::memory_order_relaxed);
+            site.retry_ns = counters.retry_ns.load(std::memory_order_relaxed);
+            for (size_t b = 0; b < CasSiteProfile::HISTOGRAM_BUCKETS; ++b) {
+                site.histogram[b] = counters.histogram[b].load(std::memory_order_relaxed);
+            }
+        }
+#endif
+        return profile;
+    }
+
+    /**
+     * @brief Clear the CAS contention profile
+     * @note Counters updated concurrently may survive the reset
+     */
+    void reset_cas_profile() noexcept {
+#ifdef SLICK_OBJECT_POOL_PROFILE_CAS
+        for (auto& counters : cas_sites_) {
+            counters.operations.store(0, std::memory_order_relaxed);
+            counters.attempts.store(0, std::memory_order_relaxed);
+            counters.retry_ns.store(0, std::memory_order_relaxed);
+            for (auto& bucket : counters.histogram) {
+                bucket.store(0, std::memory_order_relaxed);
             }
+        }
+#endif
+    }
+
+private:
+    /**
+     * @brief Destroy the constructed objects and free their storage
+     */
+    void release_buffer() noexcept {
+        for (uint32_t i = 0; i < constructed_; ++i) {
+            buffer_[i].~T();
+        }
+        ::operator delete(buffer_, std::align_val_t(alignof(T)));
+        buffer_ = nullptr;
+    }
 
-            if (stored_index == std::numeric_limits<uint64_t>::max() || stored_index < current_index) {
-                // no more data available
-                return std::make_pair(nullptr, 0);
+    /**
+     * @brief Number of pool objects currently handed out
+     * @details Derived from the ring counters; approximate while other threads run
+     */
+    uint64_t outstanding() const noexcept {
+        auto available = ring_.available();
+        auto capacity = capacity_.load(std::memory_order_relaxed);
+        if (recycle_mode_ == RecycleMode::BACKGROUND) {
+            available += dirty_count_.load(std::memory_order_relaxed);   // freed, waiting for scrub()
+        }
+        return available < capacity ? capacity - available : 0;
+    }
+
+    /**
+     * @brief Publish up to n more objects, staged ones first
+     * @pre grow_mutex_ is held
+     * @return Objects published
+     */
+    uint32_t grow_locked(uint32_t n) {
+        auto capacity = capacity_.load(std::memory_order_relaxed);
+        auto count = std::min<uint32_t>(n, size_ - capacity);
+        if (count == 0) {
+            return 0;
+        }
+        auto staged = staged_.load(std::memory_order_relaxed);
+        for (; constructed_ < capacity + count; ++constructed_) {
+            new (&buffer_[constructed_]) T;
+        }
+        staged_.store(staged > count ? staged - count : 0, std::memory_order_relaxed);
+        publish_bulk(capacity, count);
+        return count;
+    }
+
+    /**
+     * @brief Publish buffer_[first, first + n) to the ring and add it to the capacity
+     */
+    void publish_bulk(uint32_t first, uint32_t n) noexcept {
+        ring_.publish_range(first, n);
+        capacity_.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Queue a freed object for scrub() (lock-free MPSC push)
+     */
+    void push_dirty(uint32_t index) noexcept {
+        auto head = dirty_head_.load(std::memory_order_relaxed);
+        do {
+            dirty_next_[index] = head;
+        } while (!dirty_head_.compare_exchange_weak(head, index, std::memory_order_release, std::memory_order_relaxed));
+        dirty_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Reset an object for reuse
+     * @details No-op for types recycler<T> cannot reset; recycle_mode() keeps those pools at NONE
+     */
+    static void recycle(T& obj) {
+        if constexpr (PoolRecyclable<T>) {
+            recycler<T>::recycle(obj);
+        }
+    }
+
+    /**
+     * @brief Recycle the objects at the given indices
+     * @details Zero-filled types are cleared one run of adjacent objects at a time
+     */
+    void recycle_batch(uint32_t* indices, uint32_t n) {
+        if constexpr (recycler<T>::zero_fill) {
+            std::sort(indices, indices + n);
+            for (uint32_t i = 0; i < n;) {
+                uint32_t run = 1;
+                while (i + run < n && indices[i + run] == indices[i] + run) {
+                    ++run;
+                }
+                std::memset(static_cast<void*>(&buffer_[indices[i]]), 0, sizeof(T) * run);
+                i += run;
             }
-            else if (stored_index > current_index && ((stored_index & mask_) != current)) [[unlikely]] {
-                // queue wrapped, skip the unused slots
-                consumed_.compare_exchange_weak(current_index, stored_index, std::memory_order_release, std::memory_order_relaxed);
-                continue;
+        } else {
+            for (uint32_t i = 0; i < n; ++i) {
+                recycle(buffer_[indices[i]]);
             }
+        }
+    }
+
+    /**
+     * @brief Raise the high-water mark to `count` if it is higher
+     * @note Only the first allocations past a new peak write the counter
+     */
+    void update_high_water_mark(uint64_t count) noexcept {
+        auto current = high_water_mark_.load(std::memory_order_relaxed);
+        while (count > current && !high_water_mark_.compare_exchange_weak(current, count, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @brief Record one operation of a CAS call site
+     *
+     * @param site Call site
+     * @param attempts CAS attempts the operation needed
+     * @param retry_start Time of the first failed CAS (default constructed if none failed)
+     */
+    void record_cas([[maybe_unused]] CasProfile::Site site, [[maybe_unused]] uint64_t attempts,
+        [[maybe_unused]] profile_clock::time_point retry_start) noexcept {
+#ifdef SLICK_OBJECT_POOL_PROFILE_CAS
+        auto& counters = cas_sites_[site];
+        counters.operations.fetch_add(1, std::memory_order_relaxed);
+        counters.attempts.fetch_add(attempts, std::memory_order_relaxed);
+        counters.histogram[CasSiteProfile::bucket_of(attempts)].fetch_add(1, std::memory_order_relaxed);
+        if (retry_start != profile_clock::time_point{}) {
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(profile_clock::now() - retry_start);
+            counters.retry_ns.fetch_add(static_cast<uint64_t>(elapsed.count()), std::memory_order_relaxed);
+        }
+#endif
+    }
 
-            // Try to atomically claim this item
-            uint64_t next_index = stored_index + current_slot->size;
-            if (consumed_.compare_exchange_weak(current_index, next_index, std::memory_order_release, std::memory_order_relaxed)) {
-                // Successfully claimed the item
-                return std::make_pair(free_objects_[current_index & mask_], current_slot->size);
+    /**
+     * @brief Take the next free object from the ring
+     *
+     * @details
+     * Wraps detail::PoolRing::consume() with the CAS profiler and the
+     * consume_retry tracepoint.
+     *
+     * @return Object pointer, or nullptr if the pool is empty
+     */
+    T* consume() noexcept {
+        uint64_t retries = 0;
+        profile_clock::time_point retry_start;
+        const uint32_t object = ring_.consume([&](uint64_t attempt) noexcept {
+            retries = attempt;
+            if constexpr (cas_profiling_enabled) {
+                if (attempt == 1) {
+                    retry_start = profile_clock::now();
+                }
+            }
+            SLICK_OBJECT_POOL_PROBE(consume_retry, reinterpret_cast<uintptr_t>(this), attempt);
+        });
+        if constexpr (cas_profiling_enabled) {
+            // The CAS that succeeded counts as an attempt too
+            const uint64_t attempts = retries + (object != detail::PoolRing::npos);
+            if (attempts) {
+                record_cas(CasProfile::CONSUME, attempts, retry_start);
             }
-            // CAS failed, another consumer claimed it, retry
         }
+        return object != detail::PoolRing::npos ? &buffer_[object] : nullptr;
     }
 };
 
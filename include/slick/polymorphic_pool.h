@@ -0,0 +1,200 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#pragma once
+
+#include "object_pool.h"
+
+#include <cstddef>
+#include <utility>
+
+namespace slick {
+
+/**
+ * @file polymorphic_pool.h
+ * @brief Lock-free pool serving several types of a class hierarchy from one ring
+ *
+ * @details
+ * PolymorphicPool keeps slots big and aligned enough for the largest of the
+ * listed types, all handed out by one ObjectPool ring. allocate<D>() builds
+ * any listed type in a slot; free() takes a Base pointer, destroys the object
+ * through the virtual destructor and returns the slot. A hierarchy of message
+ * types thus needs one pool and one ownership check instead of one per type,
+ * and free slots are shared between types.
+ *
+ * Every slot costs the size of the largest type, so keep rarely used, large
+ * types out of the list (and allocate them elsewhere) when sizes differ a lot.
+ *
+ * When the ring is exhausted the slot comes from the heap, as with ObjectPool,
+ * and free() deletes it again.
+ *
+ * @par Example
+ * @code
+ * struct Message { virtual ~Message() = default; uint64_t seq = 0; };
+ * struct Quote : Message { double bid, ask; Quote(double b, double a) : bid(b), ask(a) {} };
+ * struct Trade : Message { double price; uint32_t qty; };
+ *
+ * slick::PolymorphicPool<Message, Quote, Trade> messages(4096);
+ * Message* msg = messages.allocate<Quote>(101.25, 101.27);
+ * ...
+ * messages.free(msg);   // runs ~Quote()
+ * @endcode
+ *
+ * @tparam Base Base class with a virtual destructor
+ * @tparam Derived Types allocate() can build (Base itself if it is concrete)
+ */
+template<typename Base, typename... Derived>
+class PolymorphicPool {
+    static_assert(sizeof...(Derived) > 0, "PolymorphicPool needs at least one type");
+    static_assert(std::has_virtual_destructor_v<Base>, "Base must have a virtual destructor");
+    static_assert((std::is_base_of_v<Base, Derived> && ...), "all types must derive from Base");
+
+    template<typename D>
+    static constexpr bool listed = (std::is_same_v<D, Derived> || ...);
+
+public:
+    /// Alignment of every slot: the strictest of the listed types
+    static constexpr size_t slot_alignment = std::max({ alignof(Derived)... });
+
+    /// Size of every slot: the largest of the listed types, rounded up to slot_alignment
+    static constexpr size_t slot_size = (std::max({ sizeof(Derived)... }) + slot_alignment - 1) / slot_alignment * slot_alignment;
+
+    /// Raw storage for one object of any listed type
+    struct alignas(slot_alignment) Slot {
+        std::byte bytes[slot_size];
+    };
+
+    /**
+     * @brief Construct a pool with a fixed number of slots
+     * @param size Pool capacity (must be power of 2)
+     */
+    explicit PolymorphicPool(uint32_t size)
+        : slots_(size)
+    {}
+
+    /**
+     * @brief Construct a growable pool
+     * @param size Initial capacity (must be power of 2)
+     * @param max_size Maximum capacity (must be power of 2, >= size)
+     * @param segment_size Slots added on exhaustion (0 = fall back to heap instead)
+     */
+    PolymorphicPool(uint32_t size, uint32_t max_size, uint32_t segment_size)
+        : slots_(size, max_size, segment_size)
+    {}
+
+    // Delete copy and move operations
+    PolymorphicPool(const PolymorphicPool&) = delete;
+    PolymorphicPool& operator=(const PolymorphicPool&) = delete;
+    PolymorphicPool(PolymorphicPool&&) = delete;
+    PolymorphicPool& operator=(PolymorphicPool&&) = delete;
+
+    /**
+     * @brief Build an object of a listed type in a free slot
+     *
+     * @tparam D One of Derived
+     * @param args Constructor arguments
+     * @return Pointer to the new object (never nullptr)
+     *
+     * @throws Whatever D's constructor throws; the slot is returned first
+     *
+     * @par Thread Safety
+     * Safe to call concurrently from multiple threads (lock-free unless the
+     * pool falls back to the heap or grows)
+     */
+    template<typename D, typename... Args>
+    D* allocate(Args&&... args) {
+        static_assert(listed<D>, "type is not served by this pool");
+        Slot* slot = slots_.allocate();
+        if constexpr (std::is_nothrow_constructible_v<D, Args&&...>) {
+            return ::new (static_cast<void*>(slot)) D(std::forward<Args>(args)...);
+        } else {
+            try {
+                return ::new (static_cast<void*>(slot)) D(std::forward<Args>(args)...);
+            } catch (...) {
+                slots_.free(slot);
+                throw;
+            }
+        }
+    }
+
+    /**
+     * @brief Destroy an object and return its slot
+     *
+     * @param obj Object returned by allocate() (must not be nullptr)
+     *
+     * @details
+     * The slot address is the most derived object's address, so Base may sit
+     * at any offset within the listed types (e.g. as a second base class).
+     *
+     * @warning Do not free the same object twice
+     */
+    void free(Base* obj) {
+        void* storage = dynamic_cast<void*>(obj);
+        obj->~Base();
+        slots_.free(static_cast<Slot*>(storage));
+    }
+
+    /**
+     * @brief True if obj lives in a slot of the pool (false for heap fallbacks)
+     */
+    bool owns(const Base* obj) const noexcept {
+        return slots_.owns(static_cast<const Slot*>(dynamic_cast<const void*>(obj)));
+    }
+
+    /**
+     * @brief Get pool capacity in slots (grows up to max_size())
+     */
+    uint32_t size() const noexcept {
+        return slots_.size();
+    }
+
+    /**
+     * @brief Maximum capacity in slots
+     */
+    uint32_t max_size() const noexcept {
+        return slots_.max_size();
+    }
+
+    /**
+     * @brief Approximate number of free slots
+     */
+    uint32_t available() const noexcept {
+        return slots_.available();
+    }
+
+    /**
+     * @brief Memory a pool of the given capacity occupies
+     * @details Payload is slot_size per slot, whichever type occupies it
+     */
+    static constexpr MemoryUsage footprint(uint32_t capacity) noexcept {
+        return ObjectPool<Slot>::footprint(capacity);
+    }
+
+    /**
+     * @brief Memory this pool occupies
+     */
+    MemoryUsage memory_usage() const noexcept {
+        return slots_.memory_usage();
+    }
+
+    /**
+     * @brief Underlying slot pool, e.g. for a PoolReplenisher, trace() or profile()
+     * @warning Slots must only be allocated and freed through this PolymorphicPool
+     */
+    ObjectPool<Slot>& slots() noexcept {
+        return slots_;
+    }
+
+private:
+    ObjectPool<Slot> slots_;    ///< Shared ring of raw slots
+};
+
+}   // end namespace slick
@@ -0,0 +1,660 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#pragma once
+
+#include "object_pool.h"
+#include "pool_hash.h"
+
+#include <array>
+#include <functional>
+#include <iterator>
+#include <memory>
+
+namespace slick {
+
+/**
+ * @file pool_containers.h
+ * @brief Intrusive containers linking pooled objects by 32-bit index
+ *
+ * @details
+ * The containers link objects of one ObjectPool through the indices returned
+ * by ObjectPool::index_of() instead of pointers:
+ * - PoolList:     doubly linked list (e.g. the orders of a price level)
+ * - PoolHashMap:  open-addressing hash map from a key member to its object
+ * - PoolSkipList: ordered set keyed by a member (e.g. price levels)
+ *
+ * Links live in hooks embedded in T, so the containers never allocate per
+ * element and every link is half the size of a pointer. The hash map
+ * allocates its table once, at construction.
+ *
+ * Elements must be pool objects: heap fallback objects have no index.
+ * Containers are not thread-safe; the pool they link into may still be
+ * shared with other threads.
+ */
+
+/// Link value meaning "no object"
+inline constexpr uint32_t POOL_NIL = std::numeric_limits<uint32_t>::max();
+
+// ============================================================================
+// PoolList
+// ============================================================================
+
+/**
+ * @brief Hook embedding an object in one PoolList
+ */
+struct PoolListHook {
+    uint32_t prev = POOL_NIL;
+    uint32_t next = POOL_NIL;
+};
+
+/**
+ * @brief Intrusive doubly linked list of pooled objects
+ *
+ * @par Example
+ * @code
+ * struct Order {
+ *     uint64_t id;
+ *     slick::PoolListHook queue;
+ * };
+ * slick::ObjectPool<Order> orders(1 << 16);
+ * slick::PoolList<Order, &Order::queue> level_queue(orders);
+ * level_queue.push_back(*orders.allocate());
+ * @endcode
+ *
+ * @tparam T Pooled object type
+ * @tparam Hook Member of T linking it into this list
+ */
+template<typename T, PoolListHook T::*Hook>
+class PoolList {
+    ObjectPool<T>* pool_;
+    uint32_t head_ = POOL_NIL;
+    uint32_t tail_ = POOL_NIL;
+    uint32_t size_ = 0;
+
+public:
+    /**
+     * @brief Bidirectional iterator over the list
+     */
+    template<bool Const>
+    class basic_iterator {
+        using pool_type = std::conditional_t<Const, const ObjectPool<T>, ObjectPool<T>>;
+        pool_type* pool_ = nullptr;
+        const PoolList* list_ = nullptr;
+        uint32_t index_ = POOL_NIL;
+
+        friend class PoolList;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        basic_iterator() = default;
+        basic_iterator(pool_type* pool, const PoolList* list, uint32_t index) noexcept
+            : pool_(pool), list_(list), index_(index) {}
+
+        reference operator*() const noexcept { return pool_->object_at(index_); }
+        pointer operator->() const noexcept { return &pool_->object_at(index_); }
+
+        basic_iterator& operator++() noexcept {
+            index_ = (pool_->object_at(index_).*Hook).next;
+            return *this;
+        }
+        basic_iterator operator++(int) noexcept {
+            auto it = *this;
+            ++*this;
+            return it;
+        }
+        basic_iterator& operator--() noexcept {
+            index_ = index_ == POOL_NIL ? list_->tail_ : (pool_->object_at(index_).*Hook).prev;
+            return *this;
+        }
+        basic_iterator operator--(int) noexcept {
+            auto it = *this;
+            --*this;
+            return it;
+        }
+
+        bool operator==(const basic_iterator& other) const noexcept { return index_ == other.index_; }
+    };
+
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    /**
+     * @brief Create an empty list over a pool
+     * @param pool Pool all elements come from (must outlive the list)
+     */
+    explicit PoolList(ObjectPool<T>& pool) noexcept
+        : pool_(&pool)
+    {}
+
+    bool empty() const noexcept { return size_ == 0; }
+    uint32_t size() const noexcept { return size_; }
+
+    T& front() noexcept { assert(!empty()); return pool_->object_at(head_); }
+    T& back() noexcept { assert(!empty()); return pool_->object_at(tail_); }
+
+    iterator begin() noexcept { return { pool_, this, head_ }; }
+    iterator end() noexcept { return { pool_, this, POOL_NIL }; }
+    const_iterator begin() const noexcept { return { pool_, this, head_ }; }
+    const_iterator end() const noexcept { return { pool_, this, POOL_NIL }; }
+
+    /**
+     * @brief Append an object
+     * @param obj Pool object not linked into a list through Hook
+     */
+    void push_back(T& obj) noexcept {
+        insert(end(), obj);
+    }
+
+    /**
+     * @brief Prepend an object
+     * @param obj Pool object not linked into a list through Hook
+     */
+    void push_front(T& obj) noexcept {
+        insert(begin(), obj);
+    }
+
+    /**
+     * @brief Link obj before pos
+     * @return Iterator to obj
+     */
+    iterator insert(iterator pos, T& obj) noexcept {
+        const uint32_t index = pool_->index_of(&obj);
+        assert(index != ObjectPool<T>::npos && "only pool objects can be linked");
+        auto& hook = obj.*Hook;
+        hook.next = pos.index_;
+        hook.prev = pos.index_ == POOL_NIL ? tail_ : hook_of(pos.index_).prev;
+        if (hook.prev == POOL_NIL) {
+            head_ = index;
+        } else {
+            hook_of(hook.prev).next = index;
+        }
+        if (hook.next == POOL_NIL) {
+            tail_ = index;
+        } else {
+            hook_of(hook.next).prev = index;
+        }
+        ++size_;
+        return { pool_, this, index };
+    }
+
+    /**
+     * @brief Unlink an object of this list in O(1)
+     * @return Iterator to the element that followed obj
+     */
+    iterator erase(T& obj) noexcept {
+        auto& hook = obj.*Hook;
+        const uint32_t next = hook.next;
+        if (hook.prev == POOL_NIL) {
+            head_ = hook.next;
+        } else {
+            hook_of(hook.prev).next = hook.next;
+        }
+        if (hook.next == POOL_NIL) {
+            tail_ = hook.prev;
+        } else {
+            hook_of(hook.next).prev = hook.prev;
+        }
+        hook = PoolListHook();
+        --size_;
+        return { pool_, this, next };
+    }
+
+    /**
+     * @brief Unlink and return the first object
+     * @return First object, nullptr if the list is empty
+     */
+    T* pop_front() noexcept {
+        if (empty()) {
+            return nullptr;
+        }
+        T* obj = &pool_->object_at(head_);
+        erase(*obj);
+        return obj;
+    }
+
+    /**
+     * @brief Unlink all objects (the objects stay allocated)
+     */
+    void clear() noexcept {
+        while (!empty()) {
+            pop_front();
+        }
+    }
+
+private:
+    PoolListHook& hook_of(uint32_t index) noexcept {
+        return pool_->object_at(index).*Hook;
+    }
+};
+
+// ============================================================================
+// PoolHashMap
+// ============================================================================
+
+/**
+ * @brief Open-addressing hash map from a key member to pooled objects
+ *
+ * @details
+ * Linear probing over a power-of-2 table of 8-byte entries: the object index
+ * and 32 bits of the key's hash. Probes compare hash tags first, so a lookup
+ * touches the object only on a likely match. Deletion shifts later entries
+ * back instead of leaving tombstones, so lookups never slow down over time.
+ *
+ * The table is sized once for `capacity` elements at a load factor of at
+ * most 1/2 and never grows.
+ *
+ * @par Example
+ * @code
+ * slick::PoolHashMap<Order, &Order::id> by_id(orders, 1 << 16);
+ * by_id.insert(*order);
+ * Order* found = by_id.find(42);
+ * @endcode
+ *
+ * @tparam T Pooled object type
+ * @tparam Key Key member of T
+ * @tparam Hash Hash of the key type (mixed further before use)
+ */
+template<typename T, auto Key, typename Hash = std::hash<std::remove_cvref_t<decltype(std::declval<T&>().*Key)>>>
+class PoolHashMap {
+public:
+    using key_type = std::remove_cvref_t<decltype(std::declval<T&>().*Key)>;
+
+private:
+    struct entry {
+        uint32_t object = POOL_NIL;     ///< Object index, POOL_NIL if empty
+        uint32_t tag = 0;               ///< High 32 bits of the mixed hash
+    };
+
+    ObjectPool<T>* pool_;
+    std::unique_ptr<entry[]> table_;
+    uint32_t mask_;
+    uint32_t capacity_;
+    uint32_t size_ = 0;
+    [[no_unique_address]] Hash hash_;
+
+public:
+    /**
+     * @brief Create an empty map
+     * @param pool Pool all elements come from (must outlive the map)
+     * @param capacity Maximum number of elements
+     */
+    PoolHashMap(ObjectPool<T>& pool, uint32_t capacity)
+        : pool_(&pool)
+        , table_(new entry[table_size(capacity)])
+        , mask_(table_size(capacity) - 1)
+        , capacity_(capacity)
+    {}
+
+    bool empty() const noexcept { return size_ == 0; }
+    uint32_t size() const noexcept { return size_; }
+    uint32_t capacity() const noexcept { return capacity_; }
+
+    /**
+     * @brief Insert an object under its key
+     * @param obj Pool object
+     * @return false if the key is already present (the map is unchanged)
+     * @throws std::runtime_error If the map holds capacity() elements
+     */
+    bool insert(T& obj) {
+        const uint32_t index = pool_->index_of(&obj);
+        assert(index != ObjectPool<T>::npos && "only pool objects can be indexed");
+        const uint64_t hash = mix(obj.*Key);
+        const uint32_t tag = static_cast<uint32_t>(hash >> 32);
+        for (uint32_t pos = static_cast<uint32_t>(hash) & mask_; ; pos = (pos + 1) & mask_) {
+            auto& e = table_[pos];
+            if (e.object == POOL_NIL) {
+                if (size_ == capacity_) {
+                    throw std::runtime_error("PoolHashMap capacity " + std::to_string(capacity_) + " exceeded");
+                }
+                e.object = index;
+                e.tag = tag;
+                ++size_;
+                return true;
+            }
+            if (e.tag == tag && pool_->object_at(e.object).*Key == obj.*Key) {
+                return false;
+            }
+        }
+    }
+
+    /**
+     * @brief Find the object with a key
+     * @return Object, nullptr if absent
+     */
+    T* find(const key_type& key) noexcept {
+        const uint32_t pos = locate(key);
+        return pos == POOL_NIL ? nullptr : &pool_->object_at(table_[pos].object);
+    }
+
+    /// True if an object with the key is present
+    bool contains(const key_type& key) const noexcept {
+        return locate(key) != POOL_NIL;
+    }
+
+    /**
+     * @brief Remove the object with a key
+     * @return Removed object (still allocated), nullptr if absent
+     */
+    T* erase(const key_type& key) noexcept {
+        uint32_t pos = locate(key);
+        if (pos == POOL_NIL) {
+            return nullptr;
+        }
+        T* obj = &pool_->object_at(table_[pos].object);
+
+        // Backward shift: move later entries of the cluster into the hole
+        // unless their home position lies cyclically in (hole, entry]
+        for (uint32_t next = (pos + 1) & mask_; table_[next].object != POOL_NIL; next = (next + 1) & mask_) {
+            const uint32_t home = static_cast<uint32_t>(mix(pool_->object_at(table_[next].object).*Key)) & mask_;
+            if (((next - home) & mask_) >= ((next - pos) & mask_)) {
+                table_[pos] = table_[next];
+                pos = next;
+            }
+        }
+        table_[pos] = entry();
+        --size_;
+        return obj;
+    }
+
+    /**
+     * @brief Remove all entries (the objects stay allocated)
+     */
+    void clear() noexcept {
+        std::fill(table_.get(), table_.get() + mask_ + 1, entry());
+        size_ = 0;
+    }
+
+    /**
+     * @brief Call fn(T&) for every element, in table order
+     */
+    template<typename Fn>
+    void for_each(Fn&& fn) {
+        for (uint32_t pos = 0; pos <= mask_; ++pos) {
+            if (table_[pos].object != POOL_NIL) {
+                fn(pool_->object_at(table_[pos].object));
+            }
+        }
+    }
+
+    /**
+     * @brief Bytes of the table
+     */
+    uint64_t table_bytes() const noexcept {
+        return uint64_t(mask_ + 1) * sizeof(entry);
+    }
+
+private:
+    static uint32_t table_size(uint32_t capacity) noexcept {
+        return std::bit_ceil(std::max<uint32_t>(capacity, 1)) * 2;
+    }
+
+    /// Hash finalized with fmix64: std::hash is the identity for integers on common standard libraries
+    uint64_t mix(const key_type& key) const noexcept {
+        return detail::mix(static_cast<uint64_t>(hash_(key)));
+    }
+
+    uint32_t locate(const key_type& key) const noexcept {
+        const uint64_t hash = mix(key);
+        const uint32_t tag = static_cast<uint32_t>(hash >> 32);
+        for (uint32_t pos = static_cast<uint32_t>(hash) & mask_; ; pos = (pos + 1) & mask_) {
+            const auto& e = table_[pos];
+            if (e.object == POOL_NIL) {
+                return POOL_NIL;
+            }
+            if (e.tag == tag && pool_->object_at(e.object).*Key == key) {
+                return pos;
+            }
+        }
+    }
+};
+
+// ============================================================================
+// PoolSkipList
+// ============================================================================
+
+/**
+ * @brief Hook embedding an object in one PoolSkipList
+ * @tparam Levels Maximum tower height; 8 levels index about 4^8 = 65536 elements well
+ */
+template<uint32_t Levels = 8>
+struct PoolSkipHook {
+    static_assert(Levels > 0 && Levels <= 32);
+    static constexpr uint32_t LEVELS = Levels;
+
+    std::array<uint32_t, Levels> next;  ///< Successor per level (valid below height)
+    uint8_t height = 0;                 ///< Tower height, 0 while unlinked
+};
+
+/**
+ * @brief Ordered set of pooled objects keyed by a member
+ *
+ * @details
+ * A skip list whose towers are PoolSkipHook members of the objects, linked
+ * by index. Towers grow with probability 1/4 per level. Keys are unique;
+ * Compare orders them, so a bid side uses std::greater to keep the best price
+ * in front().
+ *
+ * @par Example
+ * @code
+ * struct Level {
+ *     int64_t price;
+ *     slick::PoolSkipHook<> book;
+ * };
+ * slick::PoolSkipList<Level, &Level::price, &Level::book, std::greater<>> bids(levels);
+ * @endcode
+ *
+ * @tparam T Pooled object type
+ * @tparam Key Key member of T
+ * @tparam Hook PoolSkipHook member of T
+ * @tparam Compare Strict weak order of keys
+ */
+template<typename T, auto Key, auto Hook, typename Compare = std::less<>>
+class PoolSkipList {
+public:
+    using key_type = std::remove_cvref_t<decltype(std::declval<T&>().*Key)>;
+
+private:
+    using hook_type = std::remove_cvref_t<decltype(std::declval<T&>().*Hook)>;
+    static constexpr uint32_t LEVELS = hook_type::LEVELS;
+
+    ObjectPool<T>* pool_;
+    std::array<uint32_t, LEVELS> head_;
+    uint32_t height_ = 1;
+    uint32_t size_ = 0;
+    uint64_t rng_;
+    [[no_unique_address]] Compare less_;
+
+public:
+    /**
+     * @brief Forward iterator in key order
+     */
+    class iterator {
+        ObjectPool<T>* pool_ = nullptr;
+        uint32_t index_ = POOL_NIL;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() = default;
+        iterator(ObjectPool<T>* pool, uint32_t index) noexcept : pool_(pool), index_(index) {}
+
+        T& operator*() const noexcept { return pool_->object_at(index_); }
+        T* operator->() const noexcept { return &pool_->object_at(index_); }
+        iterator& operator++() noexcept {
+            index_ = (pool_->object_at(index_).*Hook).next[0];
+            return *this;
+        }
+        iterator operator++(int) noexcept {
+            auto it = *this;
+            ++*this;
+            return it;
+        }
+        bool operator==(const iterator& other) const noexcept { return index_ == other.index_; }
+    };
+
+    /**
+     * @brief Create an empty set over a pool
+     * @param pool Pool all elements come from (must outlive the set)
+     * @param seed Seed of the tower height generator
+     */
+    explicit PoolSkipList(ObjectPool<T>& pool, uint64_t seed = 0x9E3779B97F4A7C15ull) noexcept
+        : pool_(&pool)
+        , rng_(seed | 1)
+    {
+        head_.fill(POOL_NIL);
+    }
+
+    bool empty() const noexcept { return size_ == 0; }
+    uint32_t size() const noexcept { return size_; }
+
+    iterator begin() noexcept { return { pool_, head_[0] }; }
+    iterator end() noexcept { return { pool_, POOL_NIL }; }
+
+    /**
+     * @brief First object in key order, nullptr if empty
+     */
+    T* front() noexcept {
+        return head_[0] == POOL_NIL ? nullptr : &pool_->object_at(head_[0]);
+    }
+
+    /**
+     * @brief Find the object with a key
+     * @return Object, nullptr if absent
+     */
+    T* find(const key_type& key) noexcept {
+        T* obj = lower_bound(key);
+        return obj && !less_(key, obj->*Key) ? obj : nullptr;
+    }
+
+    /**
+     * @brief First object whose key is not ordered before key
+     * @return Object, nullptr if none
+     */
+    T* lower_bound(const key_type& key) noexcept {
+        uint32_t index = POOL_NIL;
+        for (uint32_t level = height_; level-- > 0;) {
+            for (uint32_t next = next_of(index, level); next != POOL_NIL && less_(key_of(next), key); next = next_of(index, level)) {
+                index = next;
+            }
+        }
+        const uint32_t next = next_of(index, 0);
+        return next == POOL_NIL ? nullptr : &pool_->object_at(next);
+    }
+
+    /**
+     * @brief Link an object by its key
+     * @param obj Pool object not linked through Hook
+     * @return false if the key is already present (obj is not linked)
+     */
+    bool insert(T& obj) noexcept {
+        const uint32_t index = pool_->index_of(&obj);
+        assert(index != ObjectPool<T>::npos && "only pool objects can be linked");
+        std::array<uint32_t, LEVELS> preds;
+        find_predecessors(obj.*Key, preds);
+        const uint32_t next = next_of(preds[0], 0);
+        if (next != POOL_NIL && !less_(obj.*Key, key_of(next))) {
+            return false;
+        }
+
+        auto& hook = obj.*Hook;
+        hook.height = static_cast<uint8_t>(random_height());
+        for (uint32_t level = height_; level < hook.height; ++level) {
+            preds[level] = POOL_NIL;
+        }
+        height_ = std::max<uint32_t>(height_, hook.height);
+        for (uint32_t level = 0; level < hook.height; ++level) {
+            hook.next[level] = next_of(preds[level], level);
+            next_ref(preds[level], level) = index;
+        }
+        ++size_;
+        return true;
+    }
+
+    /**
+     * @brief Unlink an object of this set
+     */
+    void erase(T& obj) noexcept {
+        [[maybe_unused]] const uint32_t index = pool_->index_of(&obj);
+        std::array<uint32_t, LEVELS> preds;
+        find_predecessors(obj.*Key, preds);
+        auto& hook = obj.*Hook;
+        assert(next_of(preds[0], 0) == index && "object is not in this list");
+        for (uint32_t level = 0; level < hook.height; ++level) {
+            next_ref(preds[level], level) = hook.next[level];
+        }
+        hook.height = 0;
+        while (height_ > 1 && head_[height_ - 1] == POOL_NIL) {
+            --height_;
+        }
+        --size_;
+    }
+
+    /**
+     * @brief Unlink and return the first object
+     * @return First object, nullptr if empty
+     */
+    T* pop_front() noexcept {
+        T* obj = front();
+        if (obj) {
+            erase(*obj);
+        }
+        return obj;
+    }
+
+private:
+    const key_type& key_of(uint32_t index) noexcept {
+        return pool_->object_at(index).*Key;
+    }
+
+    /// Link of level `level` leaving `index` (POOL_NIL = the head)
+    uint32_t& next_ref(uint32_t index, uint32_t level) noexcept {
+        return index == POOL_NIL ? head_[level] : (pool_->object_at(index).*Hook).next[level];
+    }
+
+    uint32_t next_of(uint32_t index, uint32_t level) noexcept {
+        return next_ref(index, level);
+    }
+
+    /// Last element per level ordered before key (POOL_NIL = the head)
+    void find_predecessors(const key_type& key, std::array<uint32_t, LEVELS>& preds) noexcept {
+        uint32_t index = POOL_NIL;
+        for (uint32_t level = height_; level-- > 0;) {
+            for (uint32_t next = next_of(index, level); next != POOL_NIL && less_(key_of(next), key); next = next_of(index, level)) {
+                index = next;
+            }
+            preds[level] = index;
+        }
+    }
+
+    /// Geometric height with p = 1/4 from two random bits per level
+    uint32_t random_height() noexcept {
+        rng_ ^= rng_ << 13;
+        rng_ ^= rng_ >> 7;
+        rng_ ^= rng_ << 17;
+        uint32_t height = 1;
+        for (uint64_t bits = rng_; height < LEVELS && (bits & 3) == 0; bits >>= 2) {
+            ++height;
+        }
+        return height;
+    }
+};
+
+}   // end namespace slick
@@ -0,0 +1,41 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+namespace slick {
+
+namespace detail {
+
+/**
+ * @file pool_hash.h
+ * @brief Hash finalizer shared by the pool's hash tables
+ */
+
+/**
+ * @brief MurmurHash3 fmix64 finalizer
+ * @details Spreads sequential IDs and identity hashes (std::hash of integers
+ *          on common standard libraries) over all bits of a table index
+ */
+constexpr uint64_t mix(uint64_t h) noexcept {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+}   // end namespace detail
+
+}   // end namespace slick
@@ -0,0 +1,678 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#pragma once
+
+#include "object_pool.h"
+#include "pool_hash.h"
+
+#include <memory>
+
+namespace slick {
+
+namespace detail {
+
+/**
+ * @brief Epoch-based reclamation shared by all PoolIdIndex instances
+ *
+ * @details
+ * Each thread owns a cache-line sized record holding the global epoch it
+ * entered a read section in, or IDLE. Entering costs one exchange, leaving a
+ * plain store. The epoch moves from e to e + 1 only when every active record
+ * shows e, so memory unlinked during epoch r is unreachable once the epoch
+ * reaches r + 2. Records are reused after their thread exits and never freed.
+ */
+class ReaderEpochs {
+public:
+    static constexpr uint64_t IDLE = std::numeric_limits<uint64_t>::max();
+
+    struct alignas(64) record {
+        std::atomic_uint64_t epoch{ IDLE };
+        std::atomic_bool used{ true };
+        record* next = nullptr;
+    };
+
+    /// Calling thread's record
+    static record& local() noexcept {
+        static thread_local holder owner;
+        return *owner.rec;
+    }
+
+    static void enter(record& rec) noexcept {
+        assert(rec.epoch.load(std::memory_order_relaxed) == IDLE && "read sections do not nest");
+        rec.epoch.exchange(epoch().load(std::memory_order_relaxed), std::memory_order_seq_cst);
+    }
+
+    static void leave(record& rec) noexcept {
+        rec.epoch.store(IDLE, std::memory_order_release);
+    }
+
+    static uint64_t current() noexcept {
+        return epoch().load(std::memory_order_seq_cst);
+    }
+
+    /**
+     * @brief Advance the epoch if no thread is reading in an older one
+     * @return Epoch after the attempt
+     */
+    static uint64_t try_advance() noexcept {
+        uint64_t e = epoch().load(std::memory_order_seq_cst);
+        for (record* r = records().load(std::memory_order_acquire); r; r = r->next) {
+            const uint64_t announced = r->epoch.load(std::memory_order_seq_cst);
+            if (announced != IDLE && announced != e) {
+                return e;
+            }
+        }
+        epoch().compare_exchange_strong(e, e + 1, std::memory_order_seq_cst);
+        return epoch().load(std::memory_order_seq_cst);
+    }
+
+private:
+    /// Claims a record on a thread's first read section, releases it at thread exit
+    struct holder {
+        record* rec;
+
+        holder() : rec(claim()) {}
+        ~holder() { rec->used.store(false, std::memory_order_release); }
+    };
+
+    static std::atomic_uint64_t& epoch() noexcept {
+        static std::atomic_uint64_t e{ 0 };
+        return e;
+    }
+
+    static std::atomic<record*>& records() noexcept {
+        static std::atomic<record*> head{ nullptr };
+        return head;
+    }
+
+    static record* claim() {
+        for (record* r = records().load(std::memory_order_acquire); r; r = r->next) {
+            bool expected = false;
+            if (!r->used.load(std::memory_order_relaxed)
+                && r->used.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+                return r;
+            }
+        }
+        auto* r = new record;
+        r->next = records().load(std::memory_order_relaxed);
+        while (!records().compare_exchange_weak(r->next, r, std::memory_order_release, std::memory_order_relaxed)) {}
+        return r;
+    }
+};
+
+}   // end namespace detail
+
+/**
+ * @file pool_id_index.h
+ * @brief Lock-free index from 64-bit IDs to pooled objects
+ *
+ * @details
+ * PoolIdIndex maps IDs (e.g. exchange order IDs) to objects of one
+ * ObjectPool. It is an open-addressing, linear-probing table of 16-byte
+ * entries, each holding a key and the 32-bit object index
+ * (ObjectPool::index_of()). A lookup reads the key and the index from the
+ * same entry, so a hit costs one cache miss in the table before the object
+ * itself. Inserts and erases never allocate.
+ *
+ * insert(), find() and erase() are lock-free and may run concurrently from
+ * any number of threads. Erased entries leave tombstones. When an insert
+ * probes too far (tombstones or growth), the table is replaced: a new table
+ * of at least eight times the live IDs is linked behind the current one and every
+ * later write copies one chunk of slots into it, so the cost of resizing is
+ * spread over many operations and nobody waits for it.
+ * Tombstones are dropped in the copy. Old tables are freed once no thread
+ * can still be reading them (epoch-based reclamation, see ReaderEpochs).
+ *
+ * Only pool objects can be indexed (heap fallbacks have no index). The index
+ * does not keep objects alive: a thread that finds an object must know by
+ * other means that it is not freed concurrently, e.g. because one thread owns
+ * each order's lifecycle.
+ *
+ * @par Example
+ * @code
+ * slick::ObjectPool<Order> orders(1 << 16);
+ * slick::PoolIdIndex<Order> by_id(orders);
+ *
+ * // Add: allocate, initialize, then publish under the ID
+ * Order* order = by_id.allocate(msg.id, [&](Order& o) { o.qty = msg.qty; });
+ *
+ * // Cancel: look up, then erase and free in one step
+ * if (Order* found = by_id.find(msg.id)) { ... }
+ * by_id.free(msg.id);
+ * @endcode
+ *
+ * @tparam T Pooled object type
+ */
+template<typename T>
+class PoolIdIndex {
+public:
+    using key_type = uint64_t;
+
+    /// Reserved key values (not usable as IDs)
+    static constexpr key_type EMPTY_KEY = std::numeric_limits<uint64_t>::max();
+    static constexpr key_type SEALED_KEY = EMPTY_KEY - 1;
+
+private:
+    /// Hardware cache line size (typically 64 bytes, auto-detected if available)
+#ifdef __cpp_lib_hardware_interference_size
+    static constexpr size_t CACHE_LINE_SIZE = std::hardware_destructive_interference_size;
+#else
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+#endif
+
+    // Entry values: object indices are below PRIMED
+    static constexpr uint32_t EMPTY_VALUE = 0xFFFFFFFF;  ///< Never written
+    static constexpr uint32_t TOMBSTONE = 0xFFFFFFFE;    ///< Erased
+    static constexpr uint32_t MOVED = 0xFFFFFFFD;        ///< Migrated to the next table (object or tombstone)
+    static constexpr uint32_t MOVED_EMPTY = 0xFFFFFFFC;  ///< Migrated before any value was written
+    static constexpr uint32_t PRIMED = 0x80000000;       ///< Flag: object index being copied to the next table
+
+    static constexpr uint32_t MIN_CAPACITY = 64;
+    static constexpr uint32_t PROBE_LIMIT = 32;         ///< Insert probes that trigger a resize
+    static constexpr uint32_t COPY_CHUNK = 128;         ///< Slots copied per write during a resize
+
+    static constexpr bool is_object(uint32_t v) noexcept { return v < PRIMED; }
+    static constexpr bool is_primed(uint32_t v) noexcept { return v >= PRIMED && v < MOVED_EMPTY; }
+    static constexpr bool is_moved(uint32_t v) noexcept { return v == MOVED || v == MOVED_EMPTY; }
+
+    struct alignas(16) entry {
+        std::atomic_uint64_t key{ EMPTY_KEY };
+        std::atomic_uint32_t value{ EMPTY_VALUE };
+    };
+
+    struct table {
+        explicit table(uint32_t capacity)
+            : mask(capacity - 1)
+            , entries(new entry[capacity])
+        {}
+
+        /// Return a retired table to its initial state for reuse
+        void clear() noexcept {
+            for (uint32_t i = 0; i <= mask; ++i) {
+                entries[i].key.store(EMPTY_KEY, std::memory_order_relaxed);
+                entries[i].value.store(EMPTY_VALUE, std::memory_order_relaxed);
+            }
+            next.store(nullptr, std::memory_order_relaxed);
+            copy_cursor.store(0, std::memory_order_relaxed);
+            copied.store(0, std::memory_order_relaxed);
+        }
+
+        uint32_t capacity() const noexcept { return mask + 1; }
+
+        const uint32_t mask;
+        const std::unique_ptr<entry[]> entries;
+        std::atomic<table*> next{ nullptr };                        ///< Table being migrated into
+        table* retired_next = nullptr;                              ///< Next table in the retired list
+        uint64_t retired_epoch = 0;                                 ///< Epoch the table was unlinked in
+        alignas(CACHE_LINE_SIZE) std::atomic_uint32_t copy_cursor{ 0 };  ///< Next chunk to copy
+        std::atomic_uint32_t copied{ 0 };                           ///< Slots copied so far
+    };
+
+    enum class op { insert, erase, copy };
+
+    /**
+     * @brief Marks the calling thread as reading tables for its lifetime
+     */
+    class guard {
+        detail::ReaderEpochs::record& record_;
+
+    public:
+        guard() noexcept
+            : record_(detail::ReaderEpochs::local())
+        {
+            detail::ReaderEpochs::enter(record_);
+        }
+
+        ~guard() {
+            detail::ReaderEpochs::leave(record_);
+        }
+
+        guard(const guard&) = delete;
+        guard& operator=(const guard&) = delete;
+    };
+
+    ObjectPool<T>* pool_;
+    alignas(CACHE_LINE_SIZE) std::atomic<table*> top_;     ///< Oldest table still reachable
+    std::atomic<table*> spare_{ nullptr };                  ///< Reclaimed table kept for the next resize
+    std::atomic<table*> retired_{ nullptr };                ///< Unlinked tables waiting for reclamation (lock-free stack)
+    std::atomic_uint64_t resizes_{ 0 };
+
+public:
+    /**
+     * @brief Create an empty index over a pool
+     *
+     * @param pool Pool all indexed objects come from (must outlive the index)
+     * @param capacity Expected number of IDs (0 = the pool's current size)
+     */
+    explicit PoolIdIndex(ObjectPool<T>& pool, uint32_t capacity = 0)
+        : pool_(&pool)
+        , top_(new table(table_capacity(capacity ? capacity : pool.size())))
+    {
+        assert(pool.max_size() <= PRIMED && "pool too large for 31-bit object indices");
+    }
+
+    ~PoolIdIndex() noexcept {
+        for (table* t = top_.load(std::memory_order_acquire); t;) {
+            table* next = t->next.load(std::memory_order_acquire);
+            delete t;
+            t = next;
+        }
+        for (table* t = retired_.load(std::memory_order_acquire); t;) {
+            table* next = t->retired_next;
+            delete t;
+            t = next;
+        }
+        delete spare_.load(std::memory_order_acquire);
+    }
+
+    PoolIdIndex(const PoolIdIndex&) = delete;
+    PoolIdIndex& operator=(const PoolIdIndex&) = delete;
+
+    /**
+     * @brief Index a pool object under an ID
+     *
+     * @param key ID (not EMPTY_KEY or SEALED_KEY)
+     * @param obj Pool object, fully initialized (other threads may find it immediately)
+     * @return false if the ID is already indexed or obj is a heap fallback object
+     */
+    bool insert(key_type key, T* obj) {
+        assert(key < SEALED_KEY && "reserved key");
+        const uint32_t index = pool_->index_of(obj);
+        if (index == ObjectPool<T>::npos) [[unlikely]] {
+            return false;
+        }
+        maintain();
+        guard g;
+        return put(top_.load(std::memory_order_seq_cst), key, index, op::insert) == EMPTY_VALUE;
+    }
+
+    /**
+     * @brief Find the object indexed under an ID
+     * @return Object, nullptr if the ID is not indexed
+     */
+    T* find(key_type key) const noexcept {
+        guard g;
+        const uint64_t hash = mix(key);
+        for (table* t = top_.load(std::memory_order_seq_cst); t;) {
+            table* next = nullptr;
+            uint32_t pos = static_cast<uint32_t>(hash) & t->mask;
+            for (uint32_t probes = 0; probes <= t->mask; ++probes, pos = (pos + 1) & t->mask) {
+                const entry& e = t->entries[pos];
+                const uint64_t k = e.key.load(std::memory_order_acquire);
+                if (k == key) {
+                    const uint32_t v = e.value.load(std::memory_order_acquire);
+                    if (is_object(v) || is_primed(v)) {
+                        return &pool_->object_at(v & ~PRIMED);
+                    }
+                    if (!is_moved(v)) {
+                        return nullptr;     // erased or not yet published
+                    }
+                    next = t->next.load(std::memory_order_acquire);
+                    break;
+                }
+                if (k == EMPTY_KEY) {
+                    return nullptr;
+                }
+                if (k == SEALED_KEY) {
+                    next = t->next.load(std::memory_order_acquire);
+                    break;
+                }
+            }
+            t = next ? next : t->next.load(std::memory_order_acquire);
+        }
+        return nullptr;
+    }
+
+    /// True if the ID is indexed
+    bool contains(key_type key) const noexcept {
+        return find(key) != nullptr;
+    }
+
+    /**
+     * @brief Remove an ID
+     * @return Object it was indexed with (still allocated), nullptr if not indexed
+     */
+    T* erase(key_type key) {
+        assert(key < SEALED_KEY && "reserved key");
+        maintain();
+        guard g;
+        const uint32_t index = put(top_.load(std::memory_order_seq_cst), key, 0, op::erase);
+        return index == EMPTY_VALUE ? nullptr : &pool_->object_at(index);
+    }
+
+    /**
+     * @brief Allocate a pool object, initialize it and index it under an ID
+     *
+     * @param key ID
+     * @param init Called with the object before it becomes findable
+     * @return Object, or nullptr if the ID is already indexed or the pool is
+     *         exhausted (heap fallbacks cannot be indexed)
+     */
+    template<typename Init>
+    T* allocate(key_type key, Init&& init) {
+        T* obj = pool_->allocate();
+        if (!pool_->owns(obj)) [[unlikely]] {
+            pool_->free(obj);
+            return nullptr;
+        }
+        init(*obj);
+        if (!insert(key, obj)) [[unlikely]] {
+            pool_->free(obj);
+            return nullptr;
+        }
+        return obj;
+    }
+
+    /// @copydoc allocate(key_type, Init&&)
+    T* allocate(key_type key) {
+        return allocate(key, [](T&) {});
+    }
+
+    /**
+     * @brief Remove an ID and return its object to the pool
+     * @return false if the ID was not indexed
+     */
+    bool free(key_type key) {
+        T* obj = erase(key);
+        if (!obj) {
+            return false;
+        }
+        pool_->free(obj);
+        return true;
+    }
+
+    /**
+     * @brief Number of indexed IDs
+     * @details Scans the table (O(capacity)); exact while no other thread writes
+     */
+    uint64_t size() const noexcept {
+        guard g;
+        uint64_t live = 0;
+        for (table* t = top_.load(std::memory_order_seq_cst); t; t = t->next.load(std::memory_order_acquire)) {
+            for (uint32_t i = 0; i <= t->mask; ++i) {
+                live += is_object(t->entries[i].value.load(std::memory_order_relaxed));
+            }
+        }
+        return live;
+    }
+
+    /**
+     * @brief Slots of the newest table
+     */
+    uint32_t capacity() const noexcept {
+        guard g;
+        table* t = top_.load(std::memory_order_seq_cst);
+        while (table* next = t->next.load(std::memory_order_acquire)) {
+            t = next;
+        }
+        return t->capacity();
+    }
+
+    /// Number of table replacements so far
+    uint64_t resizes() const noexcept {
+        return resizes_.load(std::memory_order_relaxed);
+    }
+
+    /// Bytes per table slot
+    static constexpr size_t entry_bytes() noexcept {
+        return sizeof(entry);
+    }
+
+private:
+    static uint32_t table_capacity(uint64_t expected) noexcept {
+        return std::max<uint32_t>(MIN_CAPACITY, static_cast<uint32_t>(std::bit_ceil(std::max<uint64_t>(expected, 1)) * 2));
+    }
+
+    /// Hash spreading sequential IDs
+    static uint64_t mix(uint64_t key) noexcept {
+        return detail::mix(key);
+    }
+
+    /**
+     * @brief Insert, erase or migrate one key, starting at table t
+     *
+     * @details
+     * A key is looked up along its probe sequence; an insert claims the first
+     * empty slot. While t is being migrated, writers first copy the key's
+     * slot to the next table (or seal the empty slot ending its probe
+     * sequence) and then operate there, so a key is only ever written in the
+     * newest table that holds it. Copies (op::copy) only fill slots nobody
+     * has written yet, so a late copy never resurrects an erased key.
+     *
+     * @return insert: EMPTY_VALUE on success, else the existing object index
+     *         erase: the removed object index, EMPTY_VALUE if absent
+     */
+    uint32_t put(table* t, key_type key, uint32_t object, op what) {
+        const uint64_t hash = mix(key);
+        while (true) {
+            if (what != op::copy && t->next.load(std::memory_order_acquire)) [[unlikely]] {
+                help_copy(t);
+            }
+
+            entry* e = nullptr;
+            uint32_t pos = static_cast<uint32_t>(hash) & t->mask;
+            for (uint32_t probes = 0; probes <= t->mask; ++probes, pos = (pos + 1) & t->mask) {
+                entry& slot = t->entries[pos];
+                uint64_t k = slot.key.load(std::memory_order_acquire);
+                if (k == EMPTY_KEY) {
+                    if (what == op::erase) {
+                        return EMPTY_VALUE;
+                    }
+                    if (what == op::insert && probes >= PROBE_LIMIT) [[unlikely]] {
+                        start_resize(t);
+                    }
+                    // Claim the slot, or seal it if the key must go to the next table
+                    const uint64_t claim = t->next.load(std::memory_order_acquire) ? SEALED_KEY : key;
+                    if (slot.key.compare_exchange_strong(k, claim, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                        k = claim;
+                    }
+                }
+                if (k == key) {
+                    e = &slot;
+                    break;
+                }
+                if (k == SEALED_KEY) {
+                    break;
+                }
+            }
+
+            if (e) {
+                uint32_t v = e->value.load(std::memory_order_acquire);
+                while (true) {
+                    if (is_moved(v)) {
+                        if (what == op::copy && v == MOVED) {
+                            return EMPTY_VALUE;     // a newer state of the key was migrated already
+                        }
+                        break;
+                    }
+                    if (what == op::copy) {
+                        if (v != EMPTY_VALUE) {
+                            return EMPTY_VALUE;     // already copied or written since
+                        }
+                        if (e->value.compare_exchange_weak(v, object, std::memory_order_release, std::memory_order_acquire)) {
+                            return EMPTY_VALUE;
+                        }
+                        continue;
+                    }
+                    if (is_primed(v) || t->next.load(std::memory_order_acquire)) [[unlikely]] {
+                        copy_slot(t, *e);
+                        break;
+                    }
+                    if (what == op::insert) {
+                        if (is_object(v)) {
+                            return v;
+                        }
+                        if (e->value.compare_exchange_weak(v, object, std::memory_order_release, std::memory_order_acquire)) {
+                            return EMPTY_VALUE;
+                        }
+                    } else {
+                        if (!is_object(v)) {
+                            return EMPTY_VALUE;
+                        }
+                        if (e->value.compare_exchange_weak(v, TOMBSTONE, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                            return v;
+                        }
+                    }
+                }
+            }
+
+            // Key sealed out of t, migrated, or t is full: continue in the next table
+            table* next = t->next.load(std::memory_order_acquire);
+            if (!next) {
+                start_resize(t);
+                next = t->next.load(std::memory_order_acquire);
+            }
+            t = next;
+        }
+    }
+
+    /**
+     * @brief Migrate one slot of t to t->next
+     * @details Idempotent; any number of threads may copy the same slot
+     */
+    void copy_slot(table* t, entry& e) {
+        uint64_t k = e.key.load(std::memory_order_acquire);
+        while (k == EMPTY_KEY) {
+            if (e.key.compare_exchange_weak(k, SEALED_KEY, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                return;
+            }
+        }
+        if (k == SEALED_KEY) {
+            return;
+        }
+        uint32_t v = e.value.load(std::memory_order_acquire);
+        while (true) {
+            if (is_moved(v)) {
+                return;
+            }
+            if (v == EMPTY_VALUE || v == TOMBSTONE) {
+                if (e.value.compare_exchange_weak(v, v == EMPTY_VALUE ? MOVED_EMPTY : MOVED, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    return;
+                }
+                continue;
+            }
+            if (is_object(v)) {
+                // Freeze the value, then copy it
+                if (!e.value.compare_exchange_weak(v, v | PRIMED, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    continue;
+                }
+                v |= PRIMED;
+            }
+            put(t->next.load(std::memory_order_acquire), k, v & ~PRIMED, op::copy);
+            e.value.compare_exchange_strong(v, MOVED, std::memory_order_acq_rel, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    /**
+     * @brief Copy the next chunk of t's slots; promote t's successor once all are copied
+     */
+    void help_copy(table* t) {
+        const uint32_t start = t->copy_cursor.fetch_add(COPY_CHUNK, std::memory_order_relaxed);
+        if (start > t->mask) {
+            return;
+        }
+        const uint32_t end = std::min(start + COPY_CHUNK, t->capacity());
+        for (uint32_t i = start; i < end; ++i) {
+            copy_slot(t, t->entries[i]);
+        }
+        if (t->copied.fetch_add(end - start, std::memory_order_acq_rel) + (end - start) == t->capacity()) {
+            promote();
+        }
+    }
+
+    /**
+     * @brief Link a new table behind t (no-op if one exists)
+     * @details Sized from the IDs live in t, so the index also shrinks after a burst
+     */
+    void start_resize(table* t) {
+        if (t->next.load(std::memory_order_acquire)) {
+            return;
+        }
+        uint64_t live = 0;
+        for (uint32_t i = 0; i <= t->mask; ++i) {
+            const uint32_t v = t->entries[i].value.load(std::memory_order_relaxed);
+            live += is_object(v) || is_primed(v);
+        }
+        const uint32_t capacity = table_capacity(live * 4);
+        table* next = spare_.exchange(nullptr, std::memory_order_acquire);
+        if (next && next->capacity() == capacity) {
+            next->clear();
+        } else {
+            delete next;
+            next = new table(capacity);
+        }
+        table* expected = nullptr;
+        if (t->next.compare_exchange_strong(expected, next, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            resizes_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            recycle(next);
+        }
+    }
+
+    /// Keep an unreachable table as the spare, or free it
+    void recycle(table* t) noexcept {
+        table* expected = nullptr;
+        if (!spare_.compare_exchange_strong(expected, t, std::memory_order_release, std::memory_order_relaxed)) {
+            delete t;
+        }
+    }
+
+    /**
+     * @brief Unlink fully copied tables from the front of the chain
+     */
+    void promote() {
+        table* top = top_.load(std::memory_order_acquire);
+        while (top->copied.load(std::memory_order_acquire) == top->capacity()) {
+            table* next = top->next.load(std::memory_order_acquire);
+            if (top_.compare_exchange_strong(top, next, std::memory_order_seq_cst, std::memory_order_acquire)) {
+                top->retired_epoch = detail::ReaderEpochs::current();
+                push_retired(top);
+                top = next;
+            }
+        }
+    }
+
+    /// Push an unlinked table onto the retired stack
+    void push_retired(table* t) noexcept {
+        t->retired_next = retired_.load(std::memory_order_relaxed);
+        while (!retired_.compare_exchange_weak(t->retired_next, t, std::memory_order_release, std::memory_order_relaxed)) {}
+    }
+
+    /**
+     * @brief Free retired tables no reader can hold any more
+     * @details Never blocks: takes the whole retired stack, so concurrent
+     *          callers work on disjoint tables, and pushes back the tables
+     *          readers may still hold
+     */
+    void maintain() noexcept {
+        if (!retired_.load(std::memory_order_relaxed)) [[likely]] {
+            return;
+        }
+        table* t = retired_.exchange(nullptr, std::memory_order_acquire);
+        if (!t) {
+            return;
+        }
+        const uint64_t epoch = detail::ReaderEpochs::try_advance();
+        while (t) {
+            table* next = t->retired_next;
+            if (t->retired_epoch + 2 <= epoch) {
+                recycle(t);
+            } else {
+                push_retired(t);
+            }
+            t = next;
+        }
+    }
+};
+
+}   // end namespace slick
@@ -0,0 +1,172 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#pragma once
+
+#include "maintenance_thread.h"
+#include "object_pool.h"
+
+#include <chrono>
+
+namespace slick {
+
+/**
+ * @brief When a PoolReplenisher grows, stages and trims a pool
+ *
+ * @details
+ * On every check the replenisher compares the pool's free objects with the
+ * watermarks:
+ * - below low_water:     grow() by segment_size (publishing staged objects first)
+ * - below prepare_water: stage() a segment so the next growth costs no construction
+ * - above trim_water for trim_after consecutive checks: trim_staged()
+ *
+ * Watermarks of 0 are derived from segment_size: low = segment / 4,
+ * prepare = segment, trim = 2 * segment.
+ */
+struct ReplenishPolicy {
+    uint32_t segment_size = 1024;   ///< Objects added per growth
+    uint32_t low_water = 0;         ///< Grow when fewer objects are free
+    uint32_t prepare_water = 0;     ///< Stage a segment when fewer objects are free
+    uint32_t trim_water = 0;        ///< Consider trimming when more objects are free
+    uint32_t trim_after = 1000;     ///< Consecutive checks above trim_water before trimming (0 = never trim)
+};
+
+/**
+ * @file pool_replenisher.h
+ * @brief Background thread growing pools ahead of exhaustion
+ *
+ * @details
+ * A growable ObjectPool grows when allocate() finds it empty, which puts the
+ * construction of a whole segment on that caller's critical path. A
+ * PoolReplenisher moves this work to a maintenance thread: it
+ * polls the free capacity of every watched pool, constructs segments before
+ * the pool runs dry and publishes them with one bulk publish. Pools can be
+ * watched by one replenisher each or share one per group.
+ *
+ * The thread runs at normal priority. With idle_priority it runs under
+ * SCHED_IDLE on Linux and only uses otherwise idle CPU time; on a saturated
+ * machine it may then not run at all and the pools fall back to inline growth
+ * or the heap. Elsewhere idle_priority has no effect.
+ *
+ * @par Example
+ * @code
+ * slick::ObjectPool<Order> orders(4096, 1 << 20, 0);     // grow only in the background
+ * slick::PoolReplenisher replenisher(std::chrono::microseconds(100));
+ * replenisher.watch(orders, { .segment_size = 4096 });
+ * replenisher.start();
+ * @endcode
+ */
+class PoolReplenisher {
+public:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Create a stopped replenisher
+     * @param interval Time between checks of the watched pools
+     * @param idle_priority Run the thread under SCHED_IDLE (Linux only)
+     */
+    explicit PoolReplenisher(clock::duration interval = std::chrono::milliseconds(1), bool idle_priority = false)
+        : thread_(interval, idle_priority)
+    {}
+
+    /**
+     * @brief Stops the thread
+     * @warning Watched pools must outlive the replenisher or be destroyed after stop()
+     */
+    ~PoolReplenisher() {
+        stop();
+    }
+
+    PoolReplenisher(const PoolReplenisher&) = delete;
+    PoolReplenisher& operator=(const PoolReplenisher&) = delete;
+
+    /**
+     * @brief Add a pool to the group
+     *
+     * @param pool Pool to maintain (must outlive the replenisher or stop())
+     * @param policy Segment size and watermarks
+     *
+     * @note May be called while running
+     */
+    template<typename T>
+    void watch(ObjectPool<T>& pool, ReplenishPolicy policy = {}) {
+        if (policy.segment_size == 0) {
+            policy.segment_size = 1;
+        }
+        if (policy.low_water == 0) {
+            policy.low_water = std::max<uint32_t>(1, policy.segment_size / 4);
+        }
+        if (policy.prepare_water == 0) {
+            policy.prepare_water = std::max(policy.segment_size, policy.low_water);
+        }
+        if (policy.trim_water == 0) {
+            policy.trim_water = 2 * policy.segment_size;
+        }
+
+        thread_.add([&pool, policy, idle = uint32_t(0)]() mutable -> uint64_t {
+            auto available = pool.available();
+            if (available < policy.low_water) {
+                idle = 0;
+                return pool.grow(policy.segment_size) != 0 ? 1 : 0;
+            }
+            if (available < policy.prepare_water) {
+                idle = 0;
+                if (pool.staged() == 0) {
+                    pool.stage(policy.segment_size);
+                }
+                return 0;
+            }
+            if (policy.trim_after && available > policy.trim_water && pool.staged()) {
+                if (++idle >= policy.trim_after) {
+                    idle = 0;
+                    pool.trim_staged();
+                }
+            } else {
+                idle = 0;
+            }
+            return 0;
+        });
+    }
+
+    /**
+     * @brief Start the maintenance thread (no-op if running)
+     */
+    void start() {
+        thread_.start();
+    }
+
+    /**
+     * @brief Stop and join the maintenance thread
+     */
+    void stop() {
+        thread_.stop();
+    }
+
+    /**
+     * @brief Check every watched pool once on the calling thread
+     * @return Number of pools that grew
+     */
+    uint32_t check() {
+        return static_cast<uint32_t>(thread_.run_once());
+    }
+
+    /// Total number of growths performed
+    uint64_t growths() const noexcept {
+        return thread_.work();
+    }
+
+private:
+    // A pool that just grew may still be draining fast, so the thread checks
+    // again right away after a pass that grew one
+    detail::MaintenanceThread thread_;  ///< Checks every watched pool, counting growths
+};
+
+}   // end namespace slick
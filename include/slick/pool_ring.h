@@ -0,0 +1,337 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+namespace slick {
+
+namespace detail {
+
+/**
+ * @file pool_ring.h
+ * @brief Lock-free MPMC ring of free object indices shared by the pools
+ *
+ * @details
+ * ObjectPool, ThreadAffinePool, SoaObjectPool and LifetimePool hand out
+ * indices into their own storage through this ring. Producers reserve a ring
+ * index with one fetch_add and publish into its slot; consumers claim the
+ * slot at the consumer index with one CAS. Slots are never reset: each one
+ * carries the lap tag of the index that published it, so a slot left over
+ * from an earlier lap or generation is recognized as stale.
+ */
+class PoolRing {
+    /// Hardware cache line size (typically 64 bytes, auto-detected if available)
+#ifdef __cpp_lib_hardware_interference_size
+    static constexpr size_t CACHE_LINE_SIZE = std::hardware_destructive_interference_size;
+#else
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+#endif
+
+public:
+    /**
+     * @brief Ring buffer slot
+     *
+     * @details
+     * One 64-bit word: the lap tag of the ring index that published it (see
+     * tag()) in the high half and a run of free objects in the low half: the
+     * index of the first object in the low log2(size) bits, the number of
+     * further objects in the run above them. A slot is valid for ring index i
+     * only while its lap tag equals the tag of i, so slots of earlier laps and
+     * of earlier generations (see reset()) are stale without being rewritten.
+     * Consumers split a run in place (see consume()).
+     */
+    using slot = std::atomic_uint64_t;
+
+    /// Returned by consume() when the ring is empty
+    static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * @brief Create a ring whose first `fill` positions hold objects 0 to fill - 1
+     *
+     * @param size Ring size = largest object index + 1 (must be power of 2)
+     * @param fill Objects available from the start (the initial fill, <= size)
+     *
+     * @throws std::bad_alloc If the slots cannot be allocated
+     */
+    explicit PoolRing(uint32_t size, uint32_t fill = 0)
+        : control_(static_cast<slot*>(std::calloc(size, sizeof(slot))))
+        , mask_(size - 1)
+        , lap_shift_(static_cast<uint32_t>(std::countr_zero(size)))
+    {
+        assert((size && !(size & (size - 1))) && "ring size must be power of 2");
+        assert(fill <= size && "initial fill must not exceed the ring size");
+
+        // Zero bytes are EMPTY_SLOT: the ring is ready without touching it, and
+        // large rings come straight from zero pages the OS commits on first use
+        if (!control_) {
+            throw std::bad_alloc();
+        }
+        reserved_.store(fill, std::memory_order_relaxed);
+        fill_end_.store(fill, std::memory_order_relaxed);
+    }
+
+    ~PoolRing() noexcept {
+        std::free(control_);
+        control_ = nullptr;
+    }
+
+    PoolRing(const PoolRing&) = delete;
+    PoolRing& operator=(const PoolRing&) = delete;
+
+    /// Ring size
+    uint32_t size() const noexcept {
+        return mask_ + 1;
+    }
+
+    /**
+     * @brief Most objects one slot can hold as a run: 2^(32 - log2(size))
+     */
+    uint64_t max_run() const noexcept {
+        return uint64_t(1) << (32 - lap_shift_);
+    }
+
+    /**
+     * @brief Reserve the next ring index for writing
+     *
+     * @return Ring index to pass to publish()
+     *
+     * @note Wait-free: one fetch_add, like publish_range()
+     */
+    uint64_t reserve() noexcept {
+        return reserved_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Make an object available at a reserved ring index
+     *
+     * @details
+     * The slot only moves forward: a producer that reserved its index before
+     * a concurrent reset() carries the lap of the previous generation and must
+     * not overwrite a slot already published by the new one.
+     *
+     * @param index Index returned by reserve()
+     * @param object Object index (first of the run, < size())
+     * @param more Objects following it in the run (< max_run())
+     *
+     * @note Uses release memory ordering for synchronization
+     */
+    void publish(uint64_t index, uint32_t object, uint32_t more = 0) noexcept {
+        auto& slot = control_[index & mask_];
+        const uint32_t tag = this->tag(index);
+        const uint64_t value = (uint64_t(tag) << 32) | (uint64_t(more) << lap_shift_) | object;
+        auto current = slot.load(std::memory_order_relaxed);
+        while (static_cast<int32_t>(tag - static_cast<uint32_t>(current >> 32)) > 0
+            && !slot.compare_exchange_weak(current, value, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @brief Publish objects [first, first + n) as runs with one reservation
+     *
+     * @details
+     * One slot per max_run() objects. Slots are published last to first, so
+     * consumers see the whole range once the first slot is visible.
+     */
+    void publish_range(uint32_t first, uint32_t n) noexcept {
+        if (n == 0) {
+            return;
+        }
+        const uint64_t run = max_run();
+        const auto slots = static_cast<uint32_t>((n + run - 1) / run);
+        run_objects_.fetch_add(n - slots, std::memory_order_relaxed);
+        const uint64_t index = reserved_.fetch_add(slots, std::memory_order_relaxed);
+        for (uint32_t i = slots; i-- > 0;) {
+            const uint64_t start = first + i * run;
+            const auto count = static_cast<uint32_t>(std::min<uint64_t>(run, uint64_t(first) + n - start));
+            publish(index + i, static_cast<uint32_t>(start), count - 1);
+        }
+    }
+
+    /**
+     * @brief Publish the objects at the given indices with one reservation
+     * @details Adjacent entries holding consecutive indices share a slot as a run
+     */
+    void publish_indices(const uint32_t* indices, uint32_t n) noexcept {
+        if (n == 0) {
+            return;
+        }
+        const uint64_t run = max_run();
+        uint32_t slots = 0;
+        for (uint32_t i = 0; i < n; ++slots) {
+            uint32_t length = 1;
+            while (i + length < n && length < run && indices[i + length] == indices[i] + length) {
+                ++length;
+            }
+            i += length;
+        }
+        run_objects_.fetch_add(n - slots, std::memory_order_relaxed);
+        const uint64_t index = reserved_.fetch_add(slots, std::memory_order_relaxed);
+        for (uint32_t i = 0, s = 0; i < n; ++s) {
+            uint32_t length = 1;
+            while (i + length < n && length < run && indices[i + length] == indices[i] + length) {
+                ++length;
+            }
+            publish(index + s, indices[i], length - 1);
+            i += length;
+        }
+    }
+
+    /**
+     * @brief Claim the next object
+     *
+     * @details
+     * The slot at the consumer index holds a run of objects when its lap tag
+     * matches the index. A run of one is claimed by advancing the consumer
+     * index; a longer run is split in place: a CAS on the slot takes its first
+     * object and leaves the rest, so the index only moves on with the last
+     * object. A run's slot cannot be reused by a later lap before that.
+     *
+     * Otherwise the index may still lie in the initial fill of the current
+     * generation, [generation start, fill end), where ring position p
+     * implicitly holds object p & (size - 1): construction and reset() make
+     * objects available without writing a slot. Anything else means the ring
+     * is empty.
+     *
+     * @param on_retry Called with the attempt number after each failed CAS
+     * @return Object index, or npos if the ring is empty
+     *
+     * @note Lock-free operation using CAS
+     * @note May retry multiple times under high contention
+     */
+    template<typename OnRetry>
+    uint32_t consume(OnRetry&& on_retry) noexcept {
+        uint64_t attempts = 0;
+        while (true) {
+            uint64_t current_index = consumed_.load(std::memory_order_acquire);
+            auto& slot = control_[current_index & mask_];
+            uint64_t value = slot.load(std::memory_order_acquire);
+            uint32_t object;
+            bool split = false;
+            if (static_cast<uint32_t>(value >> 32) == tag(current_index)) [[likely]] {
+                object = static_cast<uint32_t>(value) & mask_;
+                split = static_cast<uint32_t>(value) > mask_;
+            }
+            else if (current_index < fill_end_.load(std::memory_order_acquire)) {
+                object = static_cast<uint32_t>(current_index & mask_);
+            }
+            else {
+                // no more data available
+                return npos;
+            }
+
+            // Try to atomically claim this item
+            ++attempts;
+            if (split) [[unlikely]] {
+                // Leave the rest of the run (next object, one fewer following) in the slot
+                if (slot.compare_exchange_weak(value, value - (uint64_t(1) << lap_shift_) + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                    run_objects_.fetch_sub(1, std::memory_order_relaxed);
+                    return object;
+                }
+            }
+            else if (consumed_.compare_exchange_weak(current_index, current_index + 1, std::memory_order_release, std::memory_order_relaxed)) {
+                return object;
+            }
+            // CAS failed, another consumer claimed it, retry
+            on_retry(attempts);
+        }
+    }
+
+    /// @copydoc consume(OnRetry&&)
+    uint32_t consume() noexcept {
+        return consume([](uint64_t) noexcept {});
+    }
+
+    /**
+     * @brief Make objects 0 to fill - 1 the only available objects, in O(1)
+     *
+     * @details
+     * The counters jump to a new generation that starts on a fresh lap past
+     * every index reserved so far, so every slot written before becomes stale
+     * through its lap tag, and the new generation's initial fill covers
+     * objects [0, fill).
+     *
+     * @param fill Objects available after the reset (<= size())
+     * @pre No other thread calls reset() concurrently
+     */
+    void reset(uint32_t fill) noexcept {
+        run_objects_.store(0, std::memory_order_relaxed);
+
+        auto reserved = reserved_.load(std::memory_order_relaxed);
+        uint64_t start;
+        do {
+            start = (reserved + mask_) & ~uint64_t(mask_);
+        } while (!reserved_.compare_exchange_weak(reserved, start + fill, std::memory_order_relaxed, std::memory_order_relaxed));
+
+        // Consumers that see the new start before the new fill find the ring
+        // briefly empty, never an object of the old generation
+        consumed_.store(start, std::memory_order_release);
+        fill_end_.store(start + fill, std::memory_order_release);
+    }
+
+    /**
+     * @brief Approximate number of objects in the ring
+     * @details Derived from the counters; exact only while no other thread runs
+     */
+    uint64_t available() const noexcept {
+        auto consumed = consumed_.load(std::memory_order_relaxed);
+        auto reserved = reserved_.load(std::memory_order_relaxed);
+        return (reserved > consumed ? reserved - consumed : 0)
+            + static_cast<uint64_t>(std::max<int64_t>(run_objects_.load(std::memory_order_relaxed), 0));
+    }
+
+    /**
+     * @brief Bytes of ring state held in the ring object itself (no padding)
+     * @details The slots add size() * sizeof(slot) bytes on the heap
+     */
+    static constexpr uint64_t state_bytes() noexcept {
+        return sizeof(control_) + sizeof(mask_) + sizeof(lap_shift_) + sizeof(reserved_) + sizeof(consumed_)
+            + sizeof(fill_end_) + sizeof(run_objects_);
+    }
+
+private:
+    /// Slot value before first use: lap tag 0, one lap before lap 0 (all-zero, so the ring needs no initialization)
+    static constexpr uint64_t EMPTY_SLOT = 0;
+    static_assert(sizeof(slot) == sizeof(uint64_t) && slot::is_always_lock_free, "ring slots must be plain 64-bit words");
+
+    /**
+     * @brief Lap tag of a ring index (see slot)
+     * @details The lap (index >> log2(size)) plus one, truncated to 32 bits, so tag 0 (EMPTY_SLOT) is one lap before lap 0
+     */
+    uint32_t tag(uint64_t index) const noexcept {
+        return static_cast<uint32_t>(index >> lap_shift_) + 1;
+    }
+
+    // Read-mostly descriptor: every consume() and publish() reads it, nothing
+    // writes it after construction. Its own cache line keeps it Shared in
+    // every core's cache instead of being invalidated by the counters below.
+    slot* control_ = nullptr;       ///< Ring buffer slots (zero-filled allocation)
+    uint32_t mask_;                 ///< Bitmask for index wrapping (size - 1)
+    uint32_t lap_shift_;            ///< log2(size): ring index >> lap_shift_ is its lap
+
+    // Cache-line aligned atomics to prevent false sharing
+    alignas(CACHE_LINE_SIZE) std::atomic_uint_fast64_t reserved_{ 0 };  ///< Next ring index to publish (own cache line)
+    alignas(CACHE_LINE_SIZE) std::atomic_uint_fast64_t consumed_{ 0 };  ///< Next ring index to consume (own cache line)
+    std::atomic_uint_fast64_t fill_end_{ 0 };   ///< End of the current generation's initial fill (see consume())
+    std::atomic_int_fast64_t run_objects_{ 0 };  ///< Objects in the ring beyond the first of each run (approximate across reset())
+};
+
+}   // end namespace detail
+
+}   // end namespace slick
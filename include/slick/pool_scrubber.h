@@ -0,0 +1,115 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#pragma once
+
+#include "maintenance_thread.h"
+#include "object_pool.h"
+
+#include <chrono>
+
+namespace slick {
+
+/**
+ * @file pool_scrubber.h
+ * @brief Background thread recycling freed objects of RecycleMode::BACKGROUND pools
+ *
+ * @details
+ * In RecycleMode::BACKGROUND, free() only queues the object. A PoolScrubber
+ * periodically calls scrub() on every watched pool, which recycles queued
+ * objects in batches and returns them to the pool, so neither free() nor
+ * allocate() pays for clearing objects. One scrubber can serve a group of
+ * pools. The thread runs at normal priority, or under SCHED_IDLE on Linux
+ * with idle_priority.
+ *
+ * Objects are unavailable between free() and the next scrub, so size pools
+ * for the extra in-flight objects or keep the interval short.
+ *
+ * @par Example
+ * @code
+ * slick::ObjectPool<Message> pool(4096);
+ * pool.recycle_mode(slick::RecycleMode::BACKGROUND);
+ * slick::PoolScrubber scrubber(std::chrono::microseconds(50));
+ * scrubber.watch(pool);
+ * scrubber.start();
+ * @endcode
+ */
+class PoolScrubber {
+public:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Create a stopped scrubber
+     * @param interval Time between scrub passes when there is nothing to do
+     * @param batch Objects recycled and republished together
+     * @param idle_priority Run the thread under SCHED_IDLE (Linux only)
+     */
+    explicit PoolScrubber(clock::duration interval = std::chrono::microseconds(100), uint32_t batch = 256,
+        bool idle_priority = false)
+        : batch_(batch)
+        , thread_(interval, idle_priority)
+    {}
+
+    /**
+     * @brief Stops the thread
+     * @warning Watched pools must outlive the scrubber or be destroyed after stop()
+     */
+    ~PoolScrubber() {
+        stop();
+    }
+
+    PoolScrubber(const PoolScrubber&) = delete;
+    PoolScrubber& operator=(const PoolScrubber&) = delete;
+
+    /**
+     * @brief Add a pool to the group
+     * @param pool Pool in RecycleMode::BACKGROUND (must outlive the scrubber or stop())
+     * @note May be called while running
+     */
+    template<typename T>
+    void watch(ObjectPool<T>& pool) {
+        thread_.add([&pool, batch = batch_]() -> uint64_t { return pool.scrub(batch); });
+    }
+
+    /**
+     * @brief Start the scrubber thread (no-op if running)
+     */
+    void start() {
+        thread_.start();
+    }
+
+    /**
+     * @brief Stop and join the scrubber thread, then scrub once more
+     */
+    void stop() {
+        thread_.stop();
+        scrub();
+    }
+
+    /**
+     * @brief Scrub every watched pool once on the calling thread
+     * @return Objects returned to their pools
+     */
+    uint64_t scrub() {
+        return thread_.run_once();
+    }
+
+    /// Total number of objects recycled
+    uint64_t recycled() const noexcept {
+        return thread_.work();
+    }
+
+private:
+    uint32_t batch_;                    ///< Objects per scrub() batch
+    detail::MaintenanceThread thread_;  ///< Scrubs every watched pool, counting recycled objects
+};
+
+}   // end namespace slick
@@ -0,0 +1,311 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#pragma once
+
+#include "object_pool.h"
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+namespace slick {
+
+/**
+ * @file pooled_function.h
+ * @brief Move-only callable wrapper storing large captures in pooled slots
+ *
+ * @details
+ * std::function heap-allocates callables larger than its small buffer, which
+ * is most executor tasks. pooled_function<Sig, SlotSize> keeps callables of
+ * up to two pointers (and nothrow movable) inline and places larger ones in
+ * a fixed-size slot of a FunctionPool, an ObjectPool of raw slots. The slot is
+ * returned when the function is destroyed, on whichever thread that happens,
+ * so posting and running tasks never calls malloc while the pool has slots.
+ * When it is exhausted, slots come from the heap as with ObjectPool.
+ *
+ * Callables larger than SlotSize are rejected at compile time. Moving a
+ * pooled_function moves two pointers; the callable itself stays in its slot.
+ *
+ * @par Example
+ * @code
+ * slick::FunctionPool<256> tasks(4096);
+ *
+ * std::array<double, 16> prices = ...;
+ * slick::pooled_function<void(), 256> task(tasks, [prices, &book] { book.update(prices); });
+ * queue.push(std::move(task));
+ * ...
+ * task();   // on the worker; the slot goes back to the pool when task is destroyed
+ * @endcode
+ */
+
+template<typename Sig, size_t SlotSize = 128>
+class pooled_function;
+
+/**
+ * @brief Lock-free pool of fixed-size slots for pooled_function captures
+ *
+ * @tparam SlotSize Bytes per slot (largest callable stored; multiple of alignof(std::max_align_t))
+ */
+template<size_t SlotSize = 128>
+class FunctionPool {
+    static_assert(SlotSize > 0 && SlotSize % alignof(std::max_align_t) == 0, "SlotSize must be a multiple of alignof(std::max_align_t)");
+
+public:
+    static constexpr size_t slot_size = SlotSize;
+
+    /// Raw storage for one callable
+    struct alignas(std::max_align_t) Slot {
+        std::byte bytes[SlotSize];
+    };
+
+    /**
+     * @brief Construct a pool with a fixed number of slots
+     * @param size Pool capacity (must be power of 2)
+     */
+    explicit FunctionPool(uint32_t size)
+        : slots_(size)
+    {}
+
+    /**
+     * @brief Construct a growable pool
+     * @param size Initial capacity (must be power of 2)
+     * @param max_size Maximum capacity (must be power of 2, >= size)
+     * @param segment_size Slots added on exhaustion (0 = fall back to heap instead)
+     */
+    FunctionPool(uint32_t size, uint32_t max_size, uint32_t segment_size)
+        : slots_(size, max_size, segment_size)
+    {}
+
+    FunctionPool(const FunctionPool&) = delete;
+    FunctionPool& operator=(const FunctionPool&) = delete;
+
+    /**
+     * @brief Wrap a callable, storing it in a slot unless it fits inline
+     */
+    template<typename Sig, typename F>
+    pooled_function<Sig, SlotSize> make(F&& f) {
+        return pooled_function<Sig, SlotSize>(*this, std::forward<F>(f));
+    }
+
+    /// Get pool capacity in slots
+    uint32_t size() const noexcept {
+        return slots_.size();
+    }
+
+    /// Approximate number of free slots
+    uint32_t available() const noexcept {
+        return slots_.available();
+    }
+
+    /**
+     * @brief Underlying slot pool, e.g. for a PoolReplenisher, trace() or profile()
+     * @warning Slots must only be allocated and freed through pooled_function
+     */
+    ObjectPool<Slot>& slots() noexcept {
+        return slots_;
+    }
+
+private:
+    template<typename, size_t>
+    friend class pooled_function;
+
+    ObjectPool<Slot> slots_;
+};
+
+/**
+ * @brief Move-only callable with pooled storage for large captures
+ *
+ * @tparam R Return type
+ * @tparam Args Argument types
+ * @tparam SlotSize Slot size of the FunctionPool large callables go to
+ */
+template<typename R, typename... Args, size_t SlotSize>
+class pooled_function<R(Args...), SlotSize> {
+    static constexpr size_t INLINE_SIZE = 2 * sizeof(void*);
+
+    using pool_type = FunctionPool<SlotSize>;
+    using slot_type = typename pool_type::Slot;
+
+    /// Operations on the stored callable
+    struct vtable {
+        R (*invoke)(void* storage, Args&&... args);
+        void (*move)(void* to, void* from) noexcept;    ///< Move-construct into to, leave from destroyed
+        void (*destroy)(void* storage) noexcept;
+        bool pooled;
+    };
+
+    /// Inline storage contents for a callable in a slot
+    struct slot_ref {
+        void* object;
+        pool_type* pool;
+    };
+
+    template<typename F>
+    static constexpr bool stored_inline = sizeof(F) <= INLINE_SIZE && alignof(F) <= alignof(void*)
+        && std::is_nothrow_move_constructible_v<F>;
+
+    template<typename F>
+    static constexpr vtable inline_vtable{
+        [](void* storage, Args&&... args) -> R {
+            return std::invoke(*static_cast<F*>(storage), std::forward<Args>(args)...);
+        },
+        [](void* to, void* from) noexcept {
+            ::new (to) F(std::move(*static_cast<F*>(from)));
+            static_cast<F*>(from)->~F();
+        },
+        [](void* storage) noexcept {
+            static_cast<F*>(storage)->~F();
+        },
+        false
+    };
+
+    template<typename F>
+    static constexpr vtable pooled_vtable{
+        [](void* storage, Args&&... args) -> R {
+            return std::invoke(*static_cast<F*>(static_cast<slot_ref*>(storage)->object), std::forward<Args>(args)...);
+        },
+        [](void* to, void* from) noexcept {
+            ::new (to) slot_ref(*static_cast<slot_ref*>(from));
+        },
+        [](void* storage) noexcept {
+            auto* ref = static_cast<slot_ref*>(storage);
+            static_cast<F*>(ref->object)->~F();
+            ref->pool->slots_.free(static_cast<slot_type*>(ref->object));
+        },
+        true
+    };
+
+    template<typename F>
+    static constexpr bool callable = !std::is_same_v<std::decay_t<F>, pooled_function>
+        && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>;
+
+    const vtable* vtable_ = nullptr;
+    alignas(void*) std::byte storage_[INLINE_SIZE];
+
+public:
+    pooled_function() noexcept = default;
+
+    pooled_function(std::nullptr_t) noexcept {}
+
+    /**
+     * @brief Wrap a callable small enough to be stored inline (no pool needed)
+     */
+    template<typename F>
+        requires callable<F>
+    pooled_function(F&& f) {
+        using Fn = std::decay_t<F>;
+        static_assert(stored_inline<Fn>, "callable does not fit inline; pass a FunctionPool");
+        ::new (static_cast<void*>(storage_)) Fn(std::forward<F>(f));
+        vtable_ = &inline_vtable<Fn>;
+    }
+
+    /**
+     * @brief Wrap a callable, storing it in a slot of pool unless it fits inline
+     *
+     * @param pool Pool for large callables (must outlive the function)
+     * @param f Callable, at most SlotSize bytes
+     *
+     * @throws Whatever the callable's constructor throws; the slot is returned first
+     */
+    template<typename F>
+        requires callable<F>
+    pooled_function(pool_type& pool, F&& f) {
+        using Fn = std::decay_t<F>;
+        if constexpr (stored_inline<Fn>) {
+            ::new (static_cast<void*>(storage_)) Fn(std::forward<F>(f));
+            vtable_ = &inline_vtable<Fn>;
+        } else {
+            static_assert(sizeof(Fn) <= SlotSize, "callable does not fit a FunctionPool slot; use a larger SlotSize");
+            static_assert(alignof(Fn) <= alignof(slot_type), "callable is over-aligned for a FunctionPool slot");
+            slot_type* slot = pool.slots_.allocate();
+            if constexpr (std::is_nothrow_constructible_v<Fn, F&&>) {
+                ::new (static_cast<void*>(slot)) Fn(std::forward<F>(f));
+            } else {
+                try {
+                    ::new (static_cast<void*>(slot)) Fn(std::forward<F>(f));
+                } catch (...) {
+                    pool.slots_.free(slot);
+                    throw;
+                }
+            }
+            ::new (static_cast<void*>(storage_)) slot_ref{ slot, &pool };
+            vtable_ = &pooled_vtable<Fn>;
+        }
+    }
+
+    pooled_function(pooled_function&& other) noexcept {
+        take(other);
+    }
+
+    pooled_function& operator=(pooled_function&& other) noexcept {
+        if (this != &other) {
+            reset();
+            take(other);
+        }
+        return *this;
+    }
+
+    pooled_function& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    pooled_function(const pooled_function&) = delete;
+    pooled_function& operator=(const pooled_function&) = delete;
+
+    /**
+     * @brief Destroys the callable and returns its slot
+     */
+    ~pooled_function() {
+        reset();
+    }
+
+    /**
+     * @brief Invoke the callable
+     * @warning Must not be empty
+     */
+    R operator()(Args... args) {
+        assert(vtable_ && "empty pooled_function");
+        return vtable_->invoke(storage_, std::forward<Args>(args)...);
+    }
+
+    /// True unless empty
+    explicit operator bool() const noexcept {
+        return vtable_ != nullptr;
+    }
+
+    /// True if the callable lives in a pool slot rather than inline
+    bool pooled() const noexcept {
+        return vtable_ && vtable_->pooled;
+    }
+
+    /**
+     * @brief Destroy the callable (returning its slot) and become empty
+     */
+    void reset() noexcept {
+        if (vtable_) {
+            vtable_->destroy(storage_);
+            vtable_ = nullptr;
+        }
+    }
+
+private:
+    void take(pooled_function& other) noexcept {
+        if (other.vtable_) {
+            other.vtable_->move(storage_, other.storage_);
+            vtable_ = other.vtable_;
+            other.vtable_ = nullptr;
+        }
+    }
+};
+
+}   // end namespace slick
@@ -0,0 +1,240 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#pragma once
+
+#include "object_pool.h"
+
+#include <span>
+
+namespace slick {
+
+/**
+ * @file soa_object_pool.h
+ * @brief Lock-free structure-of-arrays pool for hot/cold field splitting
+ *
+ * @details
+ * An ObjectPool stores whole objects, so a scan over a few hot fields pulls
+ * the cold fields of every object through the cache as well. SoaObjectPool
+ * splits an object into field groups, each a default constructible struct,
+ * and keeps every group in its own contiguous, cache-line aligned array. An
+ * object is a 32-bit index valid in all arrays, so
+ * - get<G>(index) reaches one group of one object, and
+ * - array<G>() exposes a group of all objects as a dense array for scans the
+ *   compiler can vectorize.
+ *
+ * Allocation hands out indices through the same lock-free ring as ObjectPool.
+ * Since objects are identified by index, there is no heap fallback:
+ * allocate() returns npos when the pool is exhausted.
+ *
+ * array<G>() covers every object, allocated or not; free objects keep the
+ * values they had when they were freed, so scans typically skip them through
+ * a field of the hot group (e.g. quantity 0).
+ *
+ * @par Example
+ * @code
+ * struct OrderHot { double price; uint32_t qty; uint8_t side; };
+ * struct OrderCold { char client_id[16]; char tag[32]; };
+ *
+ * slick::SoaObjectPool<OrderHot, OrderCold> orders(1 << 16);
+ * auto id = orders.allocate();
+ * orders.get<OrderHot>(id) = { 101.25, 300, 'B' };
+ *
+ * double notional = 0;
+ * for (const auto& hot : orders.array<OrderHot>()) {
+ *     notional += hot.price * hot.qty;
+ * }
+ * orders.free(id);
+ * @endcode
+ *
+ * @tparam Groups Field groups, distinct default constructible types
+ */
+template<typename... Groups>
+class SoaObjectPool {
+    static_assert(sizeof...(Groups) > 0, "SoaObjectPool needs at least one field group");
+    static_assert((std::is_default_constructible_v<Groups> && ...), "field groups must be default constructible");
+
+    template<typename G>
+    static constexpr size_t occurrences = (size_t(std::is_same_v<G, Groups>) + ...);
+    static_assert(((occurrences<Groups> == 1) && ...), "field groups must be distinct types");
+
+    /// Hardware cache line size (typically 64 bytes, auto-detected if available)
+#ifdef __cpp_lib_hardware_interference_size
+    static constexpr size_t CACHE_LINE_SIZE = std::hardware_destructive_interference_size;
+#else
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+#endif
+
+    template<typename G>
+    static constexpr std::align_val_t group_alignment{ std::max(alignof(G), CACHE_LINE_SIZE) };
+
+    uint32_t size_;                 ///< Capacity (must be power of 2)
+    std::tuple<Groups*...> arrays_; ///< One array of size_ entries per field group
+    detail::PoolRing ring_;         ///< Free object indices, initial fill [0, size_)
+
+public:
+    /// Returned by allocate() when the pool is exhausted
+    static constexpr uint32_t npos = detail::PoolRing::npos;
+
+    /**
+     * @brief Construct a pool with all objects available
+     *
+     * @param size Pool capacity (must be power of 2)
+     */
+    explicit SoaObjectPool(uint32_t size)
+        : size_(size)
+        , arrays_(allocate_group<Groups>(size)...)
+        , ring_(size, size)
+    {
+        assert((size && !(size & (size - 1))) && "size must be power of 2");
+    }
+
+    ~SoaObjectPool() noexcept {
+        (release_group(std::get<Groups*>(arrays_)), ...);
+    }
+
+    // Delete copy and move operations
+    SoaObjectPool(const SoaObjectPool&) = delete;
+    SoaObjectPool& operator=(const SoaObjectPool&) = delete;
+    SoaObjectPool(SoaObjectPool&&) = delete;
+    SoaObjectPool& operator=(SoaObjectPool&&) = delete;
+
+    /**
+     * @brief Allocate an object
+     * @return Object index, or npos if the pool is exhausted
+     *
+     * @par Thread Safety
+     * Safe to call concurrently from multiple threads (lock-free)
+     */
+    uint32_t allocate() noexcept {
+        return ring_.consume();
+    }
+
+    /**
+     * @brief Return an object to the pool
+     *
+     * @param index Index returned by allocate()
+     *
+     * @warning Do not free the same index twice
+     */
+    void free(uint32_t index) noexcept {
+        assert(index < size_ && "index does not belong to the pool");
+        ring_.publish(ring_.reserve(), index);
+    }
+
+    /**
+     * @brief Access one field group of an object
+     * @tparam G Field group type
+     * @param index Object index
+     */
+    template<typename G>
+    G& get(uint32_t index) noexcept {
+        assert(index < size_);
+        return std::get<G*>(arrays_)[index];
+    }
+
+    /// @copydoc get()
+    template<typename G>
+    const G& get(uint32_t index) const noexcept {
+        assert(index < size_);
+        return std::get<G*>(arrays_)[index];
+    }
+
+    /**
+     * @brief Access one field group of an object by group position
+     * @tparam I Position of the group in Groups
+     * @param index Object index
+     */
+    template<size_t I>
+    auto& get(uint32_t index) noexcept {
+        assert(index < size_);
+        return std::get<I>(arrays_)[index];
+    }
+
+    /**
+     * @brief Field group G of all objects, indexed by object index
+     * @details The array starts on a cache line boundary
+     */
+    template<typename G>
+    std::span<G> array() noexcept {
+        return { std::get<G*>(arrays_), size_ };
+    }
+
+    /// @copydoc array()
+    template<typename G>
+    std::span<const G> array() const noexcept {
+        return { std::get<G*>(arrays_), size_ };
+    }
+
+    /**
+     * @brief Get pool capacity
+     */
+    uint32_t size() const noexcept {
+        return size_;
+    }
+
+    /**
+     * @brief Approximate number of objects ready to be allocated
+     * @details Exact only while no other thread runs
+     */
+    uint32_t available() const noexcept {
+        return static_cast<uint32_t>(std::min<uint64_t>(ring_.available(), size_));
+    }
+
+    /**
+     * @brief True if index is an object index of this pool
+     */
+    bool owns(uint32_t index) const noexcept {
+        return index < size_;
+    }
+
+    /**
+     * @brief Memory a pool of the given capacity occupies
+     * @details Payload is the sum of the group sizes per object
+     */
+    static constexpr MemoryUsage footprint(uint32_t capacity) noexcept {
+        constexpr uint64_t state_used = detail::PoolRing::state_bytes() + sizeof(size_) + sizeof(arrays_);
+
+        MemoryUsage usage;
+        usage.capacity = capacity;
+        usage.payload_bytes = uint64_t(capacity) * (sizeof(Groups) + ...);
+        usage.metadata_bytes = uint64_t(capacity) * sizeof(detail::PoolRing::slot) + state_used;
+        usage.padding_bytes = sizeof(SoaObjectPool) - state_used;
+        return usage;
+    }
+
+    /**
+     * @brief Memory this pool occupies
+     */
+    MemoryUsage memory_usage() const noexcept {
+        return footprint(size_);
+    }
+
+private:
+    template<typename G>
+    static G* allocate_group(uint32_t size) {
+        auto* array = static_cast<G*>(::operator new(sizeof(G) * size_t(size), group_alignment<G>));
+        for (uint32_t i = 0; i < size; ++i) {
+            new (&array[i]) G;
+        }
+        return array;
+    }
+
+    template<typename G>
+    void release_group(G* array) noexcept {
+        for (uint32_t i = 0; i < size_; ++i) {
+            array[i].~G();
+        }
+        ::operator delete(array, group_alignment<G>);
+    }
+};
+
+}   // end namespace slick
@@ -0,0 +1,407 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#pragma once
+
+#include "object_pool.h"
+
+namespace slick {
+
+namespace detail {
+
+/**
+ * @brief Dense per-thread index shared by all pools
+ *
+ * @details
+ * A thread claims the lowest free index on first use and releases it at
+ * thread exit, so live threads keep indices below their count. Threads
+ * beyond CAPACITY get npos.
+ */
+class ThreadIndices {
+public:
+    static constexpr uint32_t CAPACITY = 4096;
+    static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+    /// Calling thread's index
+    static uint32_t local() noexcept {
+        static thread_local holder owner;
+        return owner.index;
+    }
+
+private:
+    struct holder {
+        uint32_t index;
+
+        holder() noexcept : index(claim()) {}
+        ~holder() { release(index); }
+    };
+
+    static std::atomic_uint64_t* words() noexcept {
+        static std::atomic_uint64_t bits[CAPACITY / 64] = {};
+        return bits;
+    }
+
+    static uint32_t claim() noexcept {
+        for (uint32_t w = 0; w < CAPACITY / 64; ++w) {
+            auto& word = words()[w];
+            auto bits = word.load(std::memory_order_relaxed);
+            while (~bits) {
+                const uint32_t bit = static_cast<uint32_t>(std::countr_zero(~bits));
+                if (word.compare_exchange_weak(bits, bits | (uint64_t(1) << bit), std::memory_order_acquire, std::memory_order_relaxed)) {
+                    return w * 64 + bit;
+                }
+            }
+        }
+        return npos;
+    }
+
+    static void release(uint32_t index) noexcept {
+        if (index != npos) {
+            words()[index / 64].fetch_and(~(uint64_t(1) << (index % 64)), std::memory_order_release);
+        }
+    }
+};
+
+}   // end namespace detail
+
+/**
+ * @file thread_affine_pool.h
+ * @brief Lock-free pool handing out page-sized segments to threads
+ *
+ * @details
+ * Objects of an ObjectPool come from anywhere in its buffer, so a thread's
+ * working set spans many pages and TLB entries. ThreadAffinePool splits its
+ * buffer into page-aligned segments of segment_bytes and hands out segments
+ * rather than objects through its lock-free ring. A thread allocates from the
+ * segment it holds until the segment has no free object left, then claims
+ * another one, so its objects cluster on few pages and cache lines.
+ *
+ * Each thread allocates through its own lane (no atomic operation on the
+ * object itself, one counter update on the segment). free() may run on any
+ * thread: it pushes the object onto its segment's lock-free free list, where
+ * the holding thread picks it up once its private list runs dry. A segment
+ * the holder has given up returns to the ring when at least half of its
+ * objects are free again (all of them for segments of one object), so
+ * long-lived objects do not pin whole segments.
+ *
+ * Threads beyond max_threads share one lane under a mutex. When the ring has
+ * no segment left, objects come from the heap, as with ObjectPool.
+ *
+ * @par Example
+ * @code
+ * slick::ThreadAffinePool<Order> orders(1 << 16);   // 4 KB segments, up to 64 threads
+ *
+ * Order* order = orders.allocate();   // from the calling thread's segment
+ * ...
+ * orders.free(order);                 // from any thread
+ * @endcode
+ *
+ * @tparam T Object type to pool
+ */
+template<typename T>
+class ThreadAffinePool {
+    static_assert(std::is_default_constructible_v<T>, "T must be default constructible");
+
+    /// Hardware cache line size (typically 64 bytes, auto-detected if available)
+#ifdef __cpp_lib_hardware_interference_size
+    static constexpr size_t CACHE_LINE_SIZE = std::hardware_destructive_interference_size;
+#else
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+#endif
+
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+    /// Segment state flag: the segment is held by a lane
+    static constexpr uint32_t HELD = uint32_t(1) << 31;
+
+    /**
+     * @brief Per-segment state, one cache line each
+     * @details state is HELD | objects handed out; free_head is the first object freed since the holder last looked
+     */
+    struct alignas(CACHE_LINE_SIZE) Segment {
+        std::atomic_uint32_t state{ 0 };
+        std::atomic_uint32_t free_head{ NONE };
+    };
+
+    /// Allocation state of one thread, touched only by that thread
+    struct alignas(CACHE_LINE_SIZE) Lane {
+        uint32_t segment = NONE;    ///< Segment held (NONE = none)
+        uint32_t local_head = NONE; ///< Private free list of the held segment
+    };
+
+    uint32_t segment_count_;        ///< Segments in the pool
+    uint32_t segment_shift_;        ///< log2(segment_bytes)
+    uint32_t per_segment_;          ///< Objects per segment
+    uint32_t slot_shift_;           ///< Object index = (segment << slot_shift_) | position in the segment
+    uint32_t release_threshold_;    ///< A segment given up returns to the ring at this many objects outstanding
+    uint32_t lane_count_;           ///< Exclusive lanes (max_threads)
+    std::byte* buffer_ = nullptr;   ///< Segment storage, segment s at buffer_ + (s << segment_shift_)
+    intptr_t lower_bound_ = 0;      ///< Lower address bound for pool ownership check
+    intptr_t upper_bound_ = 0;      ///< Upper address bound for pool ownership check
+    Segment* segments_ = nullptr;   ///< Segment state
+    uint32_t* next_ = nullptr;      ///< Free list links, by object index (see slot_shift_)
+    Lane* lanes_ = nullptr;         ///< lane_count_ exclusive lanes plus the shared overflow lane
+    std::mutex overflow_mutex_;     ///< Guards the overflow lane
+    detail::PoolRing ring_;         ///< Free segments, initial fill [0, segment_count_)
+
+public:
+    /**
+     * @brief Construct a pool with all segments available
+     *
+     * @param size Minimum number of objects (rounded up to whole segments)
+     * @param segment_bytes Segment size and alignment (power of 2, >= sizeof(T); default one 4 KB page)
+     * @param max_threads Threads with an exclusive lane; others share one lane under a lock
+     */
+    explicit ThreadAffinePool(uint32_t size, uint32_t segment_bytes = 4096, uint32_t max_threads = 64)
+        : segment_count_(segments_for(size, segment_bytes))
+        , segment_shift_(static_cast<uint32_t>(std::countr_zero(segment_bytes)))
+        , per_segment_(static_cast<uint32_t>(segment_bytes / sizeof(T)))
+        , slot_shift_(static_cast<uint32_t>(std::bit_width(per_segment_ - 1)))
+        , lane_count_(max_threads)
+        , ring_(std::bit_ceil(segment_count_), segment_count_)
+    {
+        assert((segment_bytes && !(segment_bytes & (segment_bytes - 1))) && "segment_bytes must be power of 2");
+        assert(size > 0 && "size must not be 0");
+
+        release_threshold_ = per_segment_ / 2;
+
+        buffer_ = static_cast<std::byte*>(::operator new(size_t(segment_count_) << segment_shift_,
+            std::align_val_t(std::max<size_t>(segment_bytes, alignof(T)))));
+        segments_ = new Segment[segment_count_];
+        next_ = new uint32_t[size_t(segment_count_) << slot_shift_];
+        lanes_ = new Lane[size_t(lane_count_) + 1];
+
+        for (uint32_t s = 0; s < segment_count_; ++s) {
+            const uint32_t first = s << slot_shift_;
+            for (uint32_t i = 0; i < per_segment_; ++i) {
+                new (address(first + i)) T;
+                next_[first + i] = i + 1 < per_segment_ ? first + i + 1 : NONE;
+            }
+            segments_[s].free_head.store(first, std::memory_order_relaxed);
+        }
+
+        lower_bound_ = reinterpret_cast<intptr_t>(buffer_);
+        upper_bound_ = reinterpret_cast<intptr_t>(address(((segment_count_ - 1) << slot_shift_) + per_segment_ - 1));
+    }
+
+    ~ThreadAffinePool() noexcept {
+        for (uint32_t s = 0; s < segment_count_; ++s) {
+            for (uint32_t i = 0; i < per_segment_; ++i) {
+                address((s << slot_shift_) + i)->~T();
+            }
+        }
+        ::operator delete(buffer_, std::align_val_t(std::max<size_t>(size_t(1) << segment_shift_, alignof(T))));
+        buffer_ = nullptr;
+        delete[] segments_;
+        segments_ = nullptr;
+        delete[] next_;
+        next_ = nullptr;
+        delete[] lanes_;
+        lanes_ = nullptr;
+    }
+
+    // Delete copy and move operations
+    ThreadAffinePool(const ThreadAffinePool&) = delete;
+    ThreadAffinePool& operator=(const ThreadAffinePool&) = delete;
+    ThreadAffinePool(ThreadAffinePool&&) = delete;
+    ThreadAffinePool& operator=(ThreadAffinePool&&) = delete;
+
+    /**
+     * @brief Allocate an object from the calling thread's segment
+     *
+     * @return Pointer to allocated object (never nullptr; from the heap if no segment is left)
+     *
+     * @par Thread Safety
+     * Safe to call concurrently from multiple threads (lock-free for the
+     * first max_threads threads unless the pool falls back to the heap)
+     */
+    T* allocate() {
+        const uint32_t index = detail::ThreadIndices::local();
+        if (index < lane_count_) [[likely]] {
+            return allocate_from(lanes_[index]);
+        }
+        std::lock_guard lock(overflow_mutex_);
+        return allocate_from(lanes_[lane_count_]);
+    }
+
+    /**
+     * @brief Return an object to its segment, or delete it if it came from the heap
+     *
+     * @param obj Object returned by allocate() (must not be nullptr)
+     *
+     * @par Thread Safety
+     * Safe to call from any thread, not only the allocating one (lock-free)
+     *
+     * @warning Do not free the same object twice
+     */
+    void free(T* obj) {
+        if (!owns(obj)) {
+            delete obj;
+            return;
+        }
+        const uint32_t object = object_of(obj);
+        const uint32_t s = object >> slot_shift_;
+        auto& segment = segments_[s];
+        auto head = segment.free_head.load(std::memory_order_relaxed);
+        do {
+            next_[object] = head;
+        } while (!segment.free_head.compare_exchange_weak(head, object, std::memory_order_release, std::memory_order_relaxed));
+
+        // The last free before a given-up segment is half empty returns it to the ring
+        const uint32_t previous = segment.state.fetch_sub(1, std::memory_order_acq_rel);
+        if (previous == release_threshold_ + 1) {
+            ring_.publish(ring_.reserve(), s);
+        }
+    }
+
+    /**
+     * @brief Check whether an object lives in the pool's storage
+     *
+     * @param obj Object pointer
+     * @return true if obj is a pool slot, false if it came from the heap fallback
+     */
+    bool owns(const T* obj) const noexcept {
+        auto o = reinterpret_cast<intptr_t>(obj);
+        return o >= lower_bound_ && o <= upper_bound_;
+    }
+
+    /**
+     * @brief Segment an owned object belongs to
+     * @param obj Object pointer (must be owned by the pool)
+     */
+    uint32_t segment_of(const T* obj) const noexcept {
+        assert(owns(obj) && "object does not belong to the pool");
+        return static_cast<uint32_t>(static_cast<size_t>(reinterpret_cast<const std::byte*>(obj) - buffer_) >> segment_shift_);
+    }
+
+    /**
+     * @brief Get pool capacity (whole segments)
+     */
+    uint32_t size() const noexcept {
+        return segment_count_ * per_segment_;
+    }
+
+    /**
+     * @brief Number of segments
+     */
+    uint32_t segments() const noexcept {
+        return segment_count_;
+    }
+
+    /**
+     * @brief Objects per segment
+     */
+    uint32_t segment_size() const noexcept {
+        return per_segment_;
+    }
+
+    /**
+     * @brief Approximate number of objects not handed out
+     * @details Includes free objects of segments held by threads; exact only while no other thread runs
+     */
+    uint32_t available() const noexcept {
+        uint64_t outstanding = 0;
+        for (uint32_t s = 0; s < segment_count_; ++s) {
+            outstanding += segments_[s].state.load(std::memory_order_relaxed) & ~HELD;
+        }
+        return static_cast<uint32_t>(size() - std::min<uint64_t>(outstanding, size()));
+    }
+
+    /**
+     * @brief Approximate number of segments in the ring, not held by any thread
+     */
+    uint32_t free_segments() const noexcept {
+        return static_cast<uint32_t>(std::min<uint64_t>(ring_.available(), segment_count_));
+    }
+
+    /**
+     * @brief Memory this pool occupies
+     * @details The unused tail of each segment counts as padding
+     */
+    MemoryUsage memory_usage() const noexcept {
+        constexpr uint64_t state_used = detail::PoolRing::state_bytes() + sizeof(segment_count_)
+            + sizeof(segment_shift_) + sizeof(per_segment_) + sizeof(slot_shift_) + sizeof(release_threshold_)
+            + sizeof(lane_count_) + sizeof(buffer_) + sizeof(lower_bound_)
+            + sizeof(upper_bound_) + sizeof(segments_) + sizeof(next_) + sizeof(lanes_)
+            + sizeof(overflow_mutex_);
+        constexpr uint64_t segment_used = sizeof(std::atomic_uint32_t) * 2;
+        constexpr uint64_t lane_used = sizeof(uint32_t) * 2;
+
+        const uint64_t ring_size = ring_.size();
+        const uint64_t lanes = uint64_t(lane_count_) + 1;
+        MemoryUsage usage;
+        usage.capacity = size();
+        usage.payload_bytes = uint64_t(size()) * sizeof(T);
+        usage.metadata_bytes = ring_size * sizeof(detail::PoolRing::slot) + segment_count_ * segment_used
+            + (uint64_t(segment_count_) << slot_shift_) * sizeof(uint32_t) + lanes * lane_used + state_used;
+        usage.padding_bytes = sizeof(ThreadAffinePool) - state_used
+            + segment_count_ * (sizeof(Segment) - segment_used) + lanes * (sizeof(Lane) - lane_used)
+            + ((uint64_t(segment_count_) << segment_shift_) - usage.payload_bytes);
+        return usage;
+    }
+
+private:
+    static uint32_t segments_for(uint32_t size, uint32_t segment_bytes) noexcept {
+        assert(segment_bytes >= sizeof(T) && "segment_bytes must hold at least one object");
+        const auto per_segment = static_cast<uint32_t>(segment_bytes / sizeof(T));
+        return (size + per_segment - 1) / per_segment;
+    }
+
+    T* address(uint32_t object) const noexcept {
+        return reinterpret_cast<T*>(buffer_ + (size_t(object >> slot_shift_) << segment_shift_))
+            + (object & ((uint32_t(1) << slot_shift_) - 1));
+    }
+
+    uint32_t object_of(const T* obj) const noexcept {
+        const auto offset = static_cast<size_t>(reinterpret_cast<const std::byte*>(obj) - buffer_);
+        return static_cast<uint32_t>(offset >> segment_shift_) << slot_shift_
+            | static_cast<uint32_t>((offset & ((size_t(1) << segment_shift_) - 1)) / sizeof(T));
+    }
+
+    /**
+     * @brief Allocate through a lane
+     * @pre The caller has exclusive use of the lane
+     */
+    T* allocate_from(Lane& lane) {
+        while (true) {
+            if (lane.local_head != NONE) [[likely]] {
+                const uint32_t object = lane.local_head;
+                lane.local_head = next_[object];
+                segments_[lane.segment].state.fetch_add(1, std::memory_order_relaxed);
+                return address(object);
+            }
+            if (lane.segment != NONE) {
+                // Pick up objects freed into the held segment since the last look
+                auto& segment = segments_[lane.segment];
+                lane.local_head = segment.free_head.exchange(NONE, std::memory_order_acquire);
+                if (lane.local_head != NONE) {
+                    continue;
+                }
+                // Exhausted: give it up; it returns to the ring once half empty
+                const uint32_t previous = segment.state.fetch_and(~HELD, std::memory_order_acq_rel);
+                if ((previous & ~HELD) <= release_threshold_) {
+                    ring_.publish(ring_.reserve(), lane.segment);
+                }
+                lane.segment = NONE;
+            }
+            const uint32_t s = ring_.consume();
+            if (s == detail::PoolRing::npos) [[unlikely]] {
+                // No segment left - allocate from heap
+                return new T();
+            }
+            segments_[s].state.fetch_or(HELD, std::memory_order_acq_rel);
+            lane.segment = s;
+            lane.local_head = segments_[s].free_head.exchange(NONE, std::memory_order_acquire);
+        }
+    }
+};
+
+}   // end namespace slick
@@ -0,0 +1,252 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#include <gtest/gtest.h>
+#include <slick/thread_affine_pool.h>
+
+#include <algorithm>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Order {
+    uint64_t id = 0;
+    double price = 0;
+    uint32_t quantity = 0;
+};
+
+// 24 bytes: 4096 / 24 = 170 objects per segment, 16 bytes of tail padding
+struct Odd {
+    char bytes[24] = {};
+};
+
+TEST(ThreadAffinePoolTests, SegmentsArePageAligned) {
+    slick::ThreadAffinePool<Odd> pool(1000);
+    EXPECT_EQ(pool.segment_size(), 170u);
+    EXPECT_EQ(pool.segments(), 6u);
+    EXPECT_EQ(pool.size(), 1020u);
+    EXPECT_EQ(pool.available(), 1020u);
+
+    std::vector<Odd*> objects;
+    for (int i = 0; i < 170; ++i) {
+        objects.push_back(pool.allocate());
+    }
+    // One thread's first segment_size() objects fill exactly one page, from its start
+    auto first = reinterpret_cast<uintptr_t>(*std::min_element(objects.begin(), objects.end()));
+    EXPECT_EQ(first % 4096, 0u);
+    for (auto* obj : objects) {
+        EXPECT_TRUE(pool.owns(obj));
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(obj) & ~uintptr_t(4095), first);
+        EXPECT_EQ(pool.segment_of(obj), pool.segment_of(objects[0]));
+    }
+    EXPECT_EQ(pool.available(), 850u);
+
+    // The next allocation starts a new segment
+    Odd* next = pool.allocate();
+    EXPECT_NE(pool.segment_of(next), pool.segment_of(objects[0]));
+    objects.push_back(next);
+
+    for (auto* obj : objects) {
+        pool.free(obj);
+    }
+    EXPECT_EQ(pool.available(), 1020u);
+
+    auto usage = pool.memory_usage();
+    EXPECT_EQ(usage.capacity, 1020u);
+    EXPECT_EQ(usage.payload_bytes, 1020 * sizeof(Odd));
+    EXPECT_GE(usage.padding_bytes, 6 * (4096 - 170 * sizeof(Odd)));
+}
+
+TEST(ThreadAffinePoolTests, ThreadsGetSeparateSegments) {
+    slick::ThreadAffinePool<Order> pool(4096, 1024);
+    constexpr int THREADS = 4;
+    std::vector<std::vector<Order*>> held(THREADS);
+    std::atomic_int allocated{ 0 };
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 32; ++i) {
+                held[t].push_back(pool.allocate());
+            }
+            // Stay alive so no thread inherits another's lane
+            allocated.fetch_add(1);
+            while (allocated.load() < THREADS) {
+                std::this_thread::yield();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // 32 objects of 24 bytes fit one 1 KB segment, and no two threads share one
+    std::set<uint32_t> all;
+    for (auto& objects : held) {
+        std::set<uint32_t> mine;
+        for (auto* obj : objects) {
+            mine.insert(pool.segment_of(obj));
+        }
+        EXPECT_EQ(mine.size(), 1u);
+        all.insert(mine.begin(), mine.end());
+    }
+    EXPECT_EQ(all.size(), size_t(THREADS));
+
+    for (auto& objects : held) {
+        for (auto* obj : objects) {
+            pool.free(obj);
+        }
+    }
+    EXPECT_EQ(pool.available(), pool.size());
+}
+
+TEST(ThreadAffinePoolTests, FreedObjectsAreReused) {
+    slick::ThreadAffinePool<Order> pool(256, 1024);
+    std::set<Order*> seen;
+    for (int i = 0; i < 1000; ++i) {
+        Order* obj = pool.allocate();
+        seen.insert(obj);
+        pool.free(obj);
+    }
+    // Freed objects come back to the holder's segment
+    EXPECT_LE(seen.size(), pool.segment_size());
+    EXPECT_EQ(pool.available(), pool.size());
+}
+
+TEST(ThreadAffinePoolTests, GivenUpSegmentReturnsWhenHalfFree) {
+    slick::ThreadAffinePool<Order> pool(128, 1024);     // 4 segments of 42 objects
+    const uint32_t per_segment = pool.segment_size();
+    ASSERT_EQ(pool.segments(), 4u);
+
+    std::vector<Order*> first;
+    for (uint32_t i = 0; i < per_segment; ++i) {
+        first.push_back(pool.allocate());
+    }
+    Order* second = pool.allocate();    // gives up the first segment
+    EXPECT_EQ(pool.free_segments(), 2u);
+
+    // Freeing up to half of the first segment keeps it out of the ring
+    for (uint32_t i = 0; i < per_segment - per_segment / 2 - 1; ++i) {
+        pool.free(first[i]);
+    }
+    EXPECT_EQ(pool.free_segments(), 2u);
+    pool.free(first[per_segment - per_segment / 2 - 1]);
+    EXPECT_EQ(pool.free_segments(), 3u);
+
+    for (uint32_t i = per_segment - per_segment / 2; i < per_segment; ++i) {
+        pool.free(first[i]);
+    }
+    pool.free(second);
+    EXPECT_EQ(pool.free_segments(), 3u);    // the held segment stays with this thread
+    EXPECT_EQ(pool.available(), pool.size());
+}
+
+TEST(ThreadAffinePoolTests, HeapFallbackWhenExhausted) {
+    slick::ThreadAffinePool<Order> pool(32, 256);   // 4 segments of 10 objects
+    std::vector<Order*> objects;
+    for (uint32_t i = 0; i < pool.size(); ++i) {
+        objects.push_back(pool.allocate());
+        EXPECT_TRUE(pool.owns(objects.back()));
+    }
+    Order* heap = pool.allocate();
+    EXPECT_FALSE(pool.owns(heap));
+    pool.free(heap);
+
+    for (auto* obj : objects) {
+        pool.free(obj);
+    }
+    EXPECT_EQ(pool.available(), pool.size());
+    EXPECT_TRUE(pool.owns(pool.allocate()));
+}
+
+TEST(ThreadAffinePoolTests, OverflowThreadsShareLane) {
+    slick::ThreadAffinePool<Order> pool(1024, 1024, 1);
+    Order* main_obj = pool.allocate();  // threads other than the one with index 0 share the overflow lane
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::vector<Order*> objects;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 100; ++i) {
+                Order* obj = pool.allocate();
+                std::lock_guard lock(mutex);
+                objects.push_back(obj);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    std::set<Order*> unique(objects.begin(), objects.end());
+    EXPECT_EQ(unique.size(), objects.size());
+    EXPECT_EQ(unique.count(main_obj), 0u);
+    for (auto* obj : objects) {
+        pool.free(obj);
+    }
+    pool.free(main_obj);
+    EXPECT_EQ(pool.available(), pool.size());
+}
+
+TEST(ThreadAffinePoolTests, CrossThreadFrees) {
+    constexpr int PRODUCERS = 3;
+    constexpr int ITERATIONS = 20000;
+    slick::ThreadAffinePool<Order> pool(2048, 1024);
+    std::mutex mutex;
+    std::vector<Order*> queue;
+    std::atomic_int done{ 0 };
+    std::atomic_int errors{ 0 };
+
+    // Producers allocate, a consumer checks and frees: every free is cross-thread
+    std::thread consumer([&] {
+        std::vector<Order*> batch;
+        while (true) {
+            const bool finished = done.load() == PRODUCERS;
+            {
+                std::lock_guard lock(mutex);
+                batch.swap(queue);
+            }
+            if (batch.empty() && finished) {
+                break;
+            }
+            for (auto* obj : batch) {
+                if (obj->quantity != uint32_t(obj->id % 1000)) {
+                    errors.fetch_add(1);
+                }
+                pool.free(obj);
+            }
+            batch.clear();
+        }
+    });
+    std::vector<std::thread> producers;
+    for (int t = 0; t < PRODUCERS; ++t) {
+        producers.emplace_back([&, t] {
+            for (int i = 0; i < ITERATIONS; ++i) {
+                Order* obj = pool.allocate();
+                obj->id = uint64_t(t) * ITERATIONS + i;
+                obj->quantity = uint32_t(obj->id % 1000);
+                std::lock_guard lock(mutex);
+                queue.push_back(obj);
+            }
+            done.fetch_add(1);
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    consumer.join();
+
+    EXPECT_EQ(errors.load(), 0);
+    EXPECT_EQ(pool.available(), pool.size());
+}
+
+}   // namespace
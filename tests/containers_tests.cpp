@@ -0,0 +1,173 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#include <gtest/gtest.h>
+#include <slick/pool_containers.h>
+
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+struct Order {
+    uint64_t id = 0;
+    uint32_t qty = 0;
+    slick::PoolListHook queue;
+};
+
+struct Level {
+    int64_t price = 0;
+    slick::PoolSkipHook<> book;
+};
+
+std::vector<uint64_t> ids_of(slick::PoolList<Order, &Order::queue>& list) {
+    std::vector<uint64_t> ids;
+    for (auto& order : list) {
+        ids.push_back(order.id);
+    }
+    return ids;
+}
+
+}   // namespace
+
+TEST(PoolContainersTest, IndexOf) {
+    slick::ObjectPool<Order> pool(2);
+    auto* a = pool.allocate();
+    auto* b = pool.allocate();
+    auto* heap = pool.allocate();
+    EXPECT_NE(pool.index_of(a), pool.index_of(b));
+    EXPECT_EQ(&pool.object_at(pool.index_of(b)), b);
+    EXPECT_EQ(pool.index_of(heap), slick::ObjectPool<Order>::npos);
+    pool.free(heap);
+    pool.free(b);
+    pool.free(a);
+}
+
+TEST(PoolContainersTest, List) {
+    slick::ObjectPool<Order> pool(16);
+    slick::PoolList<Order, &Order::queue> list(pool);
+    std::vector<Order*> orders;
+    for (uint64_t i = 1; i <= 5; ++i) {
+        orders.push_back(pool.allocate());
+        orders.back()->id = i;
+        list.push_back(*orders.back());
+    }
+    EXPECT_EQ(list.size(), 5);
+    EXPECT_EQ(ids_of(list), (std::vector<uint64_t>{ 1, 2, 3, 4, 5 }));
+
+    auto next = list.erase(*orders[2]);
+    EXPECT_EQ(next->id, 4);
+    list.erase(*orders[4]);                 // tail
+    list.push_front(*orders[4]);
+    list.insert(next, *orders[2]);          // back before 4
+    EXPECT_EQ(ids_of(list), (std::vector<uint64_t>{ 5, 1, 2, 3, 4 }));
+    EXPECT_EQ(list.back().id, 4);
+    EXPECT_EQ((--list.end())->id, 4);
+
+    EXPECT_EQ(list.pop_front()->id, 5);
+    EXPECT_EQ(list.front().id, 1);
+    list.clear();
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.pop_front(), nullptr);
+    for (auto* order : orders) {
+        EXPECT_EQ(order->queue.next, slick::POOL_NIL);
+        pool.free(order);
+    }
+}
+
+TEST(PoolContainersTest, HashMapMatchesUnorderedMap) {
+    constexpr uint32_t CAPACITY = 1024;
+    slick::ObjectPool<Order> pool(CAPACITY);
+    slick::PoolHashMap<Order, &Order::id> map(pool, CAPACITY);
+    std::unordered_map<uint64_t, Order*> expected;
+    std::mt19937_64 rng(7);
+
+    for (int step = 0; step < 50000; ++step) {
+        uint64_t key = (rng() % 2048) << 10;    // multiples of 1024 cluster without hash mixing
+        auto it = expected.find(key);
+        if (it == expected.end() && expected.size() < CAPACITY) {
+            auto* order = pool.allocate();
+            order->id = key;
+            ASSERT_TRUE(map.insert(*order));
+            expected.emplace(key, order);
+        } else if (it != expected.end()) {
+            ASSERT_EQ(map.find(key), it->second);
+            ASSERT_EQ(map.erase(key), it->second);
+            pool.free(it->second);
+            expected.erase(it);
+        }
+        ASSERT_EQ(map.size(), expected.size());
+    }
+    for (auto& [key, order] : expected) {
+        EXPECT_EQ(map.find(key), order);
+        EXPECT_FALSE(map.insert(*order));
+    }
+    uint32_t visited = 0;
+    map.for_each([&](Order&) { ++visited; });
+    EXPECT_EQ(visited, expected.size());
+    EXPECT_EQ(map.table_bytes(), 2 * CAPACITY * 8);
+}
+
+TEST(PoolContainersTest, HashMapCapacity) {
+    slick::ObjectPool<Order> pool(4);
+    slick::PoolHashMap<Order, &Order::id> map(pool, 2);
+    for (uint64_t i = 0; i < 2; ++i) {
+        auto* order = pool.allocate();
+        order->id = i;
+        map.insert(*order);
+    }
+    auto* order = pool.allocate();
+    order->id = 9;
+    EXPECT_THROW(map.insert(*order), std::runtime_error);
+}
+
+TEST(PoolContainersTest, SkipListMatchesMap) {
+    slick::ObjectPool<Level> pool(4096);
+    slick::PoolSkipList<Level, &Level::price, &Level::book, std::greater<>> bids(pool);
+    std::map<int64_t, Level*, std::greater<>> expected;
+    std::mt19937_64 rng(11);
+
+    for (int step = 0; step < 50000; ++step) {
+        int64_t price = static_cast<int64_t>(rng() % 3000);
+        auto it = expected.find(price);
+        if (it == expected.end()) {
+            auto* level = pool.allocate();
+            level->price = price;
+            ASSERT_TRUE(bids.insert(*level));
+            expected.emplace(price, level);
+        } else if (rng() & 1) {
+            ASSERT_EQ(bids.find(price), it->second);
+            bids.erase(*it->second);
+            pool.free(it->second);
+            expected.erase(it);
+        }
+        ASSERT_EQ(bids.size(), expected.size());
+        ASSERT_EQ(bids.front(), expected.begin()->second);
+    }
+
+    auto it = expected.begin();
+    for (auto& level : bids) {
+        ASSERT_EQ(&level, it->second);
+        ++it;
+    }
+    EXPECT_EQ(it, expected.end());
+
+    auto* below = bids.lower_bound(1500);   // best bid at or below 1500
+    EXPECT_EQ(below, expected.lower_bound(1500)->second);
+    EXPECT_FALSE(bids.insert(*below));
+
+    while (auto* level = bids.pop_front()) {
+        pool.free(level);
+    }
+    EXPECT_TRUE(bids.empty());
+}
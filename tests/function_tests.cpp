@@ -0,0 +1,176 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#include <gtest/gtest.h>
+#include <slick/pooled_function.h>
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Task = slick::pooled_function<void(), 128>;
+
+int square(int x) {
+    return x * x;
+}
+
+TEST(PooledFunctionTests, SmallCallablesStayInline) {
+    slick::pooled_function<int(int)> fn(&square);
+    EXPECT_FALSE(fn.pooled());
+    EXPECT_EQ(fn(7), 49);
+
+    int base = 10;
+    slick::pooled_function<int(int)> add([&base](int x) { return base + x; });
+    EXPECT_FALSE(add.pooled());
+    EXPECT_EQ(add(5), 15);
+
+    slick::pooled_function<int(int)> empty;
+    EXPECT_FALSE(empty);
+    EXPECT_TRUE(add);
+}
+
+TEST(PooledFunctionTests, LargeCapturesUseSlots) {
+    slick::FunctionPool<128> pool(8);
+    std::array<int, 20> values{};
+    for (int i = 0; i < 20; ++i) {
+        values[i] = i;
+    }
+
+    int sum = 0;
+    Task task(pool, [values, &sum] {
+        for (int v : values) {
+            sum += v;
+        }
+    });
+    EXPECT_TRUE(task.pooled());
+    EXPECT_EQ(pool.available(), 7u);
+    task();
+    EXPECT_EQ(sum, 190);
+
+    // Moving hands over the slot, destruction returns it
+    Task moved = std::move(task);
+    EXPECT_FALSE(task);
+    EXPECT_TRUE(moved.pooled());
+    moved();
+    EXPECT_EQ(sum, 380);
+    EXPECT_EQ(pool.available(), 7u);
+    moved = nullptr;
+    EXPECT_EQ(pool.available(), 8u);
+}
+
+TEST(PooledFunctionTests, DestroysCapturesOnce) {
+    slick::FunctionPool<128> pool(4);
+    auto counter = std::make_shared<int>(0);
+    {
+        std::array<char, 64> padding{};
+        auto task = pool.make<int()>([counter, padding] { return ++*counter + padding[0]; });
+        EXPECT_EQ(counter.use_count(), 2);
+        std::vector<slick::pooled_function<int(), 128>> tasks;
+        tasks.push_back(std::move(task));
+        tasks.resize(16);   // relocates the stored function
+        EXPECT_EQ(tasks[0](), 1);
+        EXPECT_EQ(counter.use_count(), 2);
+    }
+    EXPECT_EQ(counter.use_count(), 1);
+    EXPECT_EQ(pool.available(), 4u);
+
+    // Inline callables are destroyed too
+    {
+        slick::pooled_function<int()> small([counter] { return *counter; });
+        EXPECT_EQ(counter.use_count(), 2);
+        slick::pooled_function<int()> other = std::move(small);
+        EXPECT_EQ(counter.use_count(), 2);
+        EXPECT_EQ(other(), 1);
+    }
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST(PooledFunctionTests, ThrowingCaptureReturnsSlot) {
+    struct Throws {
+        Throws() = default;
+        Throws(const Throws&) { throw std::runtime_error("copy failed"); }
+        void operator()() const {}
+        char padding[64] = {};
+    };
+    slick::FunctionPool<128> pool(4);
+    Throws callable;
+    EXPECT_THROW(Task(pool, callable), std::runtime_error);
+    EXPECT_EQ(pool.available(), 4u);
+}
+
+TEST(PooledFunctionTests, HeapFallbackWhenExhausted) {
+    slick::FunctionPool<128> pool(2);
+    std::array<int, 16> payload{};
+    int calls = 0;
+    std::vector<Task> tasks;
+    for (int i = 0; i < 4; ++i) {
+        tasks.emplace_back(pool, [payload, &calls] { calls += 1 + payload[0]; });
+    }
+    EXPECT_EQ(pool.available(), 0u);
+    for (auto& task : tasks) {
+        task();
+    }
+    EXPECT_EQ(calls, 4);
+    tasks.clear();
+    EXPECT_EQ(pool.available(), 2u);
+}
+
+TEST(PooledFunctionTests, CrossThreadExecution) {
+    constexpr int TASKS = 20000;
+    slick::FunctionPool<128> pool(256);
+    std::mutex mutex;
+    std::vector<Task> queue;
+    std::atomic_int64_t total{ 0 };
+    std::atomic_bool done{ false };
+
+    std::thread worker([&] {
+        std::vector<Task> batch;
+        while (true) {
+            const bool finished = done.load();
+            {
+                std::lock_guard lock(mutex);
+                batch.swap(queue);
+            }
+            if (batch.empty() && finished) {
+                break;
+            }
+            for (auto& task : batch) {
+                task();
+            }
+            batch.clear();  // slots go back to the pool on the worker
+        }
+    });
+
+    for (int i = 0; i < TASKS; ++i) {
+        std::array<int64_t, 8> values{ i, 1, 1, 1, 1, 1, 1, 1 };
+        Task task(pool, [values, &total] {
+            int64_t sum = 0;
+            for (auto v : values) {
+                sum += v;
+            }
+            total.fetch_add(sum, std::memory_order_relaxed);
+        });
+        std::lock_guard lock(mutex);
+        queue.push_back(std::move(task));
+    }
+    done = true;
+    worker.join();
+
+    EXPECT_EQ(total.load(), int64_t(TASKS) * (TASKS - 1) / 2 + int64_t(TASKS) * 7);
+    EXPECT_EQ(pool.available(), 256u);
+}
+
+}   // namespace
@@ -0,0 +1,217 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#include <gtest/gtest.h>
+#include <slick/pool_id_index.h>
+
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+struct Order {
+    uint64_t id = 0;     // written through std::atomic_ref by the concurrent test
+    uint32_t qty = 0;
+};
+
+TEST(PoolIdIndexTests, InsertFindErase) {
+    slick::ObjectPool<Order> pool(64);
+    slick::PoolIdIndex<Order> index(pool);
+
+    Order* order = index.allocate(42, [](Order& o) { o.qty = 100; });
+    ASSERT_NE(order, nullptr);
+    EXPECT_EQ(index.find(42), order);
+    EXPECT_EQ(index.find(42)->qty, 100u);
+    EXPECT_TRUE(index.contains(42));
+    EXPECT_EQ(index.find(43), nullptr);
+    EXPECT_EQ(index.size(), 1u);
+
+    // Duplicate IDs are rejected and the object goes back to the pool
+    auto available = pool.available();
+    EXPECT_EQ(index.allocate(42), nullptr);
+    EXPECT_EQ(pool.available(), available);
+
+    EXPECT_EQ(index.erase(42), order);
+    EXPECT_EQ(index.find(42), nullptr);
+    EXPECT_EQ(index.erase(42), nullptr);
+    EXPECT_TRUE(index.insert(42, order));
+    EXPECT_TRUE(index.free(42));
+    EXPECT_FALSE(index.free(42));
+    EXPECT_EQ(index.size(), 0u);
+    EXPECT_EQ(pool.available(), 64u);
+}
+
+TEST(PoolIdIndexTests, HeapObjectsAreNotIndexed) {
+    slick::ObjectPool<Order> pool(4);
+    slick::PoolIdIndex<Order> index(pool);
+    std::vector<Order*> held;
+    for (int i = 0; i < 4; ++i) {
+        held.push_back(index.allocate(i));
+        ASSERT_NE(held.back(), nullptr);
+    }
+    // Exhausted: the heap fallback cannot be indexed
+    EXPECT_EQ(index.allocate(100), nullptr);
+    EXPECT_EQ(index.find(100), nullptr);
+
+    Order* heap = pool.allocate();
+    EXPECT_FALSE(pool.owns(heap));
+    EXPECT_FALSE(index.insert(100, heap));
+    pool.free(heap);
+}
+
+TEST(PoolIdIndexTests, MatchesUnorderedMap) {
+    slick::ObjectPool<Order> pool(4096);
+    slick::PoolIdIndex<Order> index(pool, 64);
+    std::unordered_map<uint64_t, Order*> reference;
+    std::mt19937_64 rng(7);
+
+    for (int step = 0; step < 200000; ++step) {
+        const uint64_t key = rng() % 8192;
+        switch (rng() % 3) {
+        case 0: {
+            Order* order = index.allocate(key);
+            if (reference.count(key) || reference.size() == pool.size()) {
+                EXPECT_EQ(order, nullptr);
+            } else {
+                ASSERT_NE(order, nullptr);
+                reference[key] = order;
+            }
+            break;
+        }
+        case 1: {
+            auto it = reference.find(key);
+            EXPECT_EQ(index.free(key), it != reference.end());
+            if (it != reference.end()) {
+                reference.erase(it);
+            }
+            break;
+        }
+        default: {
+            auto it = reference.find(key);
+            EXPECT_EQ(index.find(key), it == reference.end() ? nullptr : it->second);
+        }
+        }
+    }
+    EXPECT_EQ(index.size(), reference.size());
+    for (auto& [key, order] : reference) {
+        EXPECT_EQ(index.find(key), order);
+    }
+    // Started at 64 entries: grew with the contents
+    EXPECT_GT(index.resizes(), 0u);
+    EXPECT_GE(index.capacity(), 2 * reference.size());
+}
+
+TEST(PoolIdIndexTests, ChurnCompactsTombstones) {
+    slick::ObjectPool<Order> pool(256);
+    slick::PoolIdIndex<Order> index(pool);
+
+    // Unique, ever increasing IDs as with exchange order IDs
+    std::vector<uint64_t> live;
+    uint64_t next_id = 1;
+    for (int step = 0; step < 100000; ++step) {
+        if (live.size() == 200) {
+            ASSERT_TRUE(index.free(live.front()));
+            live.erase(live.begin());
+        }
+        ASSERT_NE(index.allocate(next_id), nullptr);
+        live.push_back(next_id++);
+    }
+    // Tombstones forced replacements, each sized from the 200 live IDs
+    EXPECT_GT(index.resizes(), 10u);
+    EXPECT_LE(index.capacity(), 2048u);
+    for (auto id : live) {
+        EXPECT_NE(index.find(id), nullptr);
+    }
+    EXPECT_EQ(index.find(live.front() - 1), nullptr);
+}
+
+TEST(PoolIdIndexTests, ConcurrentInsertFindErase) {
+    constexpr int WRITERS = 4;
+    constexpr int READERS = 2;
+    constexpr uint32_t OBJECTS_PER_WRITER = 64;
+    constexpr uint64_t OPS = 50000;
+    constexpr uint64_t RANGE = uint64_t(1) << 40;   // ID range per writer
+
+    slick::ObjectPool<Order> pool(WRITERS * OBJECTS_PER_WRITER);
+    slick::PoolIdIndex<Order> index(pool, 16);
+    std::atomic_bool done{ false };
+    std::atomic_uint64_t mismatches{ 0 };
+
+    std::vector<std::thread> threads;
+    std::vector<std::vector<Order*>> objects(WRITERS);
+    for (int w = 0; w < WRITERS; ++w) {
+        for (uint32_t i = 0; i < OBJECTS_PER_WRITER; ++i) {
+            objects[w].push_back(pool.allocate());
+        }
+    }
+    for (int w = 0; w < WRITERS; ++w) {
+        threads.emplace_back([&, w] {
+            // Each object cycles through ever larger IDs of the writer's range
+            const uint64_t base = RANGE * (w + 1);
+            for (uint64_t op = 0; op < OPS; ++op) {
+                Order* order = objects[w][op % OBJECTS_PER_WRITER];
+                const uint64_t key = base + op;
+                if (op >= OBJECTS_PER_WRITER) {
+                    if (index.erase(key - OBJECTS_PER_WRITER) != order) {
+                        mismatches.fetch_add(1);
+                    }
+                }
+                std::atomic_ref(order->id).store(key, std::memory_order_relaxed);
+                if (!index.insert(key, order)) {
+                    mismatches.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (int r = 0; r < READERS; ++r) {
+        threads.emplace_back([&, r] {
+            std::mt19937_64 rng(r);
+            while (!done.load(std::memory_order_relaxed)) {
+                const uint64_t base = RANGE * (rng() % WRITERS + 1);
+                const uint64_t key = base + rng() % OPS;
+                if (Order* order = index.find(key)) {
+                    // The object may have moved on to a later ID of the same writer since
+                    const uint64_t id = std::atomic_ref(order->id).load(std::memory_order_relaxed);
+                    if (id < key || id >= base + RANGE) {
+                        mismatches.fetch_add(1);
+                    }
+                }
+            }
+        });
+    }
+    for (int w = 0; w < WRITERS; ++w) {
+        threads[w].join();
+    }
+    done = true;
+    for (int r = 0; r < READERS; ++r) {
+        threads[WRITERS + r].join();
+    }
+
+    EXPECT_EQ(mismatches.load(), 0u);
+    EXPECT_GT(index.resizes(), 0u);
+    EXPECT_EQ(index.size(), uint64_t(WRITERS) * OBJECTS_PER_WRITER);
+    for (int w = 0; w < WRITERS; ++w) {
+        const uint64_t base = RANGE * (w + 1);
+        for (uint64_t op = OPS - OBJECTS_PER_WRITER; op < OPS; ++op) {
+            EXPECT_EQ(index.find(base + op), objects[w][op % OBJECTS_PER_WRITER]);
+        }
+        EXPECT_EQ(index.find(base + OPS - OBJECTS_PER_WRITER - 1), nullptr);
+    }
+    for (auto& list : objects) {
+        for (auto* order : list) {
+            pool.free(order);
+        }
+    }
+}
+
+}   // namespace
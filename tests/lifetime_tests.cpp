@@ -0,0 +1,185 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#include <gtest/gtest.h>
+#include <slick/lifetime_pool.h>
+
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using slick::Lifetime;
+
+struct Order {
+    uint64_t id = 0;
+    double price = 0;
+    uint32_t quantity = 0;
+};
+
+// 24 bytes: a region of 4 objects ends mid cache line
+struct Odd {
+    char bytes[24] = {};
+};
+
+TEST(LifetimePoolTests, RegionsAreSeparate) {
+    slick::LifetimePool<Order> pool(8, 16);
+    EXPECT_EQ(pool.size(Lifetime::SHORT_LIVED), 8u);
+    EXPECT_EQ(pool.size(Lifetime::LONG_LIVED), 16u);
+    EXPECT_EQ(pool.size(), 24u);
+    EXPECT_EQ(pool.available(), 24u);
+
+    std::vector<Order*> short_lived;
+    std::vector<Order*> long_lived;
+    for (int i = 0; i < 8; ++i) {
+        short_lived.push_back(pool.allocate(Lifetime::SHORT_LIVED));
+    }
+    for (int i = 0; i < 16; ++i) {
+        long_lived.push_back(pool.allocate(Lifetime::LONG_LIVED));
+    }
+    EXPECT_EQ(pool.available(), 0u);
+
+    // Short-lived objects are packed at the start, long-lived ones after them
+    for (auto* obj : short_lived) {
+        EXPECT_TRUE(pool.owns(obj));
+        EXPECT_EQ(pool.lifetime_of(obj), Lifetime::SHORT_LIVED);
+        EXPECT_LT(pool.index_of(obj), 8u);
+    }
+    for (auto* obj : long_lived) {
+        EXPECT_TRUE(pool.owns(obj));
+        EXPECT_EQ(pool.lifetime_of(obj), Lifetime::LONG_LIVED);
+        EXPECT_GE(pool.index_of(obj), 8u);
+        EXPECT_EQ(&pool.object_at(pool.index_of(obj)), obj);
+    }
+
+    for (auto* obj : short_lived) {
+        pool.free(obj);
+    }
+    EXPECT_EQ(pool.available(Lifetime::SHORT_LIVED), 8u);
+    EXPECT_EQ(pool.available(Lifetime::LONG_LIVED), 0u);
+    for (auto* obj : long_lived) {
+        pool.free(obj);
+    }
+    EXPECT_EQ(pool.available(), 24u);
+}
+
+TEST(LifetimePoolTests, ShortLivedChurnStaysInRegion) {
+    slick::LifetimePool<Order> pool(4, 64);
+    std::vector<Order*> resting;
+    for (int i = 0; i < 32; ++i) {
+        resting.push_back(pool.allocate(Lifetime::LONG_LIVED));
+    }
+
+    std::set<Order*> touched;
+    for (int i = 0; i < 1000; ++i) {
+        Order* quote = pool.allocate(Lifetime::SHORT_LIVED);
+        touched.insert(quote);
+        pool.free(quote);
+    }
+    // The churn cycles through the 4 short-lived objects only
+    EXPECT_EQ(touched.size(), 4u);
+    for (auto* obj : touched) {
+        EXPECT_EQ(pool.lifetime_of(obj), Lifetime::SHORT_LIVED);
+    }
+    for (auto* obj : resting) {
+        pool.free(obj);
+    }
+}
+
+TEST(LifetimePoolTests, LongLivedRegionStartsOnCacheLine) {
+    slick::LifetimePool<Odd> pool(4, 8);
+    Odd* first_long = nullptr;
+    for (int i = 0; i < 8; ++i) {
+        Odd* obj = pool.allocate(Lifetime::LONG_LIVED);
+        if (!first_long || obj < first_long) {
+            first_long = obj;
+        }
+    }
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(first_long) % 64, 0u);
+    EXPECT_GT(pool.extent(), pool.size());
+
+    auto usage = pool.memory_usage();
+    EXPECT_EQ(usage.capacity, 12u);
+    EXPECT_EQ(usage.payload_bytes, 12 * sizeof(Odd));
+    EXPECT_GE(usage.padding_bytes, (pool.extent() - pool.size()) * sizeof(Odd));
+    EXPECT_EQ(slick::LifetimePool<Odd>::footprint(4, 8).total_bytes(), usage.total_bytes());
+}
+
+TEST(LifetimePoolTests, HeapFallbackPerRegion) {
+    slick::LifetimePool<Order> pool(2, 2);
+    Order* a = pool.allocate(Lifetime::SHORT_LIVED);
+    Order* b = pool.allocate(Lifetime::SHORT_LIVED);
+    Order* heap = pool.allocate(Lifetime::SHORT_LIVED);
+    EXPECT_TRUE(pool.owns(a));
+    EXPECT_TRUE(pool.owns(b));
+    EXPECT_FALSE(pool.owns(heap));
+    EXPECT_EQ(pool.index_of(heap), slick::LifetimePool<Order>::npos);
+
+    // An exhausted region does not borrow from the other one
+    EXPECT_EQ(pool.available(Lifetime::LONG_LIVED), 2u);
+
+    pool.free(heap);
+    pool.free(b);
+    pool.free(a);
+    EXPECT_EQ(pool.available(Lifetime::SHORT_LIVED), 2u);
+}
+
+TEST(LifetimePoolTests, ConcurrentMixedLifetimes) {
+    constexpr int THREADS = 4;
+    constexpr int ITERATIONS = 20000;
+    slick::LifetimePool<Order> pool(256, 1024);
+    std::atomic_int errors{ 0 };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            std::vector<Order*> resting;
+            for (int i = 0; i < ITERATIONS; ++i) {
+                Order* quote = pool.allocate(Lifetime::SHORT_LIVED);
+                quote->id = (uint64_t(t) << 32) | uint32_t(i);
+                if (i % 16 == 0) {
+                    Order* order = pool.allocate(Lifetime::LONG_LIVED);
+                    order->id = quote->id;
+                    resting.push_back(order);
+                }
+                if (quote->id != ((uint64_t(t) << 32) | uint32_t(i))) {
+                    errors.fetch_add(1);
+                }
+                if (pool.owns(quote) && pool.lifetime_of(quote) != Lifetime::SHORT_LIVED) {
+                    errors.fetch_add(1);
+                }
+                pool.free(quote);
+                if (resting.size() == 64) {
+                    for (auto* order : resting) {
+                        if (order->id >> 32 != uint64_t(t) || pool.lifetime_of(order) != Lifetime::LONG_LIVED) {
+                            errors.fetch_add(1);
+                        }
+                        pool.free(order);
+                    }
+                    resting.clear();
+                }
+            }
+            for (auto* order : resting) {
+                pool.free(order);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(errors.load(), 0);
+    EXPECT_EQ(pool.available(Lifetime::SHORT_LIVED), 256u);
+    EXPECT_EQ(pool.available(Lifetime::LONG_LIVED), 1024u);
+}
+
+}   // namespace
@@ -0,0 +1,198 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#include <gtest/gtest.h>
+#include <slick/polymorphic_pool.h>
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::atomic_int live_messages{ 0 };
+
+struct Message {
+    Message() { live_messages.fetch_add(1, std::memory_order_relaxed); }
+    virtual ~Message() { live_messages.fetch_sub(1, std::memory_order_relaxed); }
+    virtual int kind() const = 0;
+    uint64_t seq = 0;
+};
+
+struct Heartbeat : Message {
+    int kind() const override { return 0; }
+};
+
+struct Quote : Message {
+    Quote(double b, double a) : bid(b), ask(a) {}
+    int kind() const override { return 1; }
+    double bid;
+    double ask;
+};
+
+struct alignas(32) Snapshot : Message {
+    int kind() const override { return 2; }
+    char levels[200] = {};
+};
+
+// Message is the second base: the Message subobject is not at the slot start
+struct Tagged {
+    virtual ~Tagged() = default;
+    char tag[24] = "tagged";
+};
+
+struct TaggedTrade : Tagged, Message {
+    int kind() const override { return 3; }
+    double price = 0;
+};
+
+struct Throwing : Message {
+    explicit Throwing(bool fail) {
+        if (fail) {
+            throw std::runtime_error("construction failed");
+        }
+    }
+    int kind() const override { return 4; }
+};
+
+using MessagePool = slick::PolymorphicPool<Message, Heartbeat, Quote, Snapshot, TaggedTrade, Throwing>;
+
+TEST(PolymorphicPoolTests, SlotFitsLargestType) {
+    EXPECT_EQ(MessagePool::slot_alignment, 32u);
+    EXPECT_GE(MessagePool::slot_size, sizeof(Snapshot));
+    EXPECT_EQ(MessagePool::slot_size % 32, 0u);
+    EXPECT_EQ(sizeof(MessagePool::Slot), MessagePool::slot_size);
+    EXPECT_EQ(MessagePool::footprint(64).payload_bytes, 64 * MessagePool::slot_size);
+}
+
+TEST(PolymorphicPoolTests, AllocateAndFreeEachType) {
+    MessagePool pool(16);
+    live_messages = 0;
+
+    std::vector<Message*> messages;
+    messages.push_back(pool.allocate<Heartbeat>());
+    messages.push_back(pool.allocate<Quote>(101.25, 101.27));
+    messages.push_back(pool.allocate<Snapshot>());
+    messages.push_back(pool.allocate<TaggedTrade>());
+    EXPECT_EQ(live_messages.load(), 4);
+    EXPECT_EQ(pool.available(), 12u);
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(messages[i]->kind(), i);
+        EXPECT_TRUE(pool.owns(messages[i]));
+    }
+    auto* quote = static_cast<Quote*>(messages[1]);
+    EXPECT_EQ(quote->bid, 101.25);
+    EXPECT_EQ(quote->ask, 101.27);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(messages[2]) % alignof(Snapshot), 0u);
+    auto* trade = static_cast<TaggedTrade*>(messages[3]);
+    EXPECT_STREQ(trade->tag, "tagged");
+
+    for (auto* msg : messages) {
+        pool.free(msg);
+    }
+    EXPECT_EQ(live_messages.load(), 0);
+    EXPECT_EQ(pool.available(), 16u);
+}
+
+TEST(PolymorphicPoolTests, TypesShareSlots) {
+    MessagePool pool(4);
+    Message* heartbeat = pool.allocate<Heartbeat>();
+    void* slot = dynamic_cast<void*>(heartbeat);
+    pool.free(heartbeat);
+
+    // A freed slot is reused by whichever type comes next
+    std::vector<Message*> messages;
+    bool reused = false;
+    for (int i = 0; i < 4; ++i) {
+        messages.push_back(pool.allocate<TaggedTrade>());
+        reused |= dynamic_cast<void*>(messages.back()) == slot;
+    }
+    EXPECT_TRUE(reused);
+    for (auto* msg : messages) {
+        pool.free(msg);
+    }
+}
+
+TEST(PolymorphicPoolTests, HeapFallbackWhenExhausted) {
+    MessagePool pool(2);
+    live_messages = 0;
+    Message* a = pool.allocate<Quote>(1.0, 2.0);
+    Message* b = pool.allocate<Snapshot>();
+    Message* heap = pool.allocate<TaggedTrade>();
+    EXPECT_TRUE(pool.owns(a));
+    EXPECT_TRUE(pool.owns(b));
+    EXPECT_FALSE(pool.owns(heap));
+    EXPECT_EQ(heap->kind(), 3);
+
+    pool.free(heap);
+    pool.free(b);
+    pool.free(a);
+    EXPECT_EQ(live_messages.load(), 0);
+    EXPECT_EQ(pool.available(), 2u);
+}
+
+TEST(PolymorphicPoolTests, ThrowingConstructorReturnsSlot) {
+    MessagePool pool(4);
+    EXPECT_THROW(pool.allocate<Throwing>(true), std::runtime_error);
+    EXPECT_EQ(pool.available(), 4u);
+    Message* ok = pool.allocate<Throwing>(false);
+    EXPECT_EQ(ok->kind(), 4);
+    pool.free(ok);
+    EXPECT_EQ(pool.available(), 4u);
+}
+
+TEST(PolymorphicPoolTests, ConcurrentMixedTypes) {
+    constexpr int THREADS = 4;
+    constexpr int ITERATIONS = 20000;
+    MessagePool pool(1024);
+    live_messages = 0;
+    std::atomic_int errors{ 0 };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            std::vector<Message*> held;
+            for (int i = 0; i < ITERATIONS; ++i) {
+                Message* msg = nullptr;
+                switch ((i + t) % 4) {
+                case 0: msg = pool.allocate<Heartbeat>(); break;
+                case 1: msg = pool.allocate<Quote>(i, i + 1); break;
+                case 2: msg = pool.allocate<Snapshot>(); break;
+                default: msg = pool.allocate<TaggedTrade>(); break;
+                }
+                msg->seq = (uint64_t(t) << 32) | uint32_t(i);
+                held.push_back(msg);
+                if (held.size() == 32) {
+                    for (auto* m : held) {
+                        if (m->seq >> 32 != uint64_t(t)) {
+                            errors.fetch_add(1);
+                        }
+                        pool.free(m);
+                    }
+                    held.clear();
+                }
+            }
+            for (auto* m : held) {
+                pool.free(m);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(errors.load(), 0);
+    EXPECT_EQ(live_messages.load(), 0);
+    EXPECT_EQ(pool.available(), 1024u);
+}
+
+}   // namespace
@@ -0,0 +1,225 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#include <gtest/gtest.h>
+#include <slick/object_pool.h>
+
+#include <algorithm>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Order {
+    uint64_t id = 0;
+    double price = 0;
+    uint32_t quantity = 0;
+};
+
+struct Counted {
+    uint64_t value = 0;
+    void recycle() noexcept {
+        value = 0;
+    }
+};
+
+// Allocates count objects and returns the lowest one if they are consecutive
+template<typename T>
+T* allocate_run(slick::ObjectPool<T>& pool, uint32_t count) {
+    std::vector<T*> objects;
+    for (uint32_t i = 0; i < count; ++i) {
+        objects.push_back(pool.allocate());
+    }
+    auto* first = *std::min_element(objects.begin(), objects.end());
+    for (auto* obj : objects) {
+        if (obj < first || obj >= first + count) {
+            return nullptr;
+        }
+    }
+    return first;
+}
+
+TEST(RangeFreeTests, BulkFreeIsSplitOnAllocate) {
+    slick::ObjectPool<Order> pool(64);
+    Order* first = allocate_run(pool, 64);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(pool.available(), 0u);
+
+    pool.free(first + 8, 32);
+    EXPECT_EQ(pool.available(), 32u);
+
+    // The run comes back object by object, in order
+    for (uint32_t i = 0; i < 32; ++i) {
+        EXPECT_EQ(pool.allocate(), first + 8 + i);
+        EXPECT_EQ(pool.available(), 31u - i);
+    }
+    Order* heap = pool.allocate();
+    EXPECT_FALSE(pool.owns(heap));
+    pool.free(heap);
+}
+
+TEST(RangeFreeTests, MixedSingleAndBulkFrees) {
+    slick::ObjectPool<Order> pool(128);
+    Order* first = allocate_run(pool, 128);
+    ASSERT_NE(first, nullptr);
+
+    pool.free(first + 3);
+    pool.free(first + 64, 64);
+    pool.free(first + 10, 5);
+    pool.free(first + 0, 0);            // no-op
+    EXPECT_EQ(pool.available(), 70u);
+
+    std::set<Order*> unique;
+    for (int i = 0; i < 70; ++i) {
+        Order* obj = pool.allocate();
+        EXPECT_TRUE(pool.owns(obj));
+        unique.insert(obj);
+    }
+    EXPECT_EQ(unique.size(), 70u);
+    EXPECT_EQ(unique.count(first + 3), 1u);
+    EXPECT_EQ(unique.count(first + 14), 1u);
+    EXPECT_EQ(unique.count(first + 127), 1u);
+    EXPECT_EQ(pool.available(), 0u);
+    EXPECT_EQ(pool.profile().fallbacks, 0u);
+
+    for (auto* obj : unique) {
+        pool.free(obj);
+    }
+    pool.free(first + 4, 6);
+    pool.free(first + 15, 49);
+    pool.free(first, 3);
+    EXPECT_EQ(pool.available(), 128u);
+}
+
+TEST(RangeFreeTests, LongRangeSpansSeveralSlots) {
+    // 2^20 objects leave 12 bits for the run length: 4096 objects per slot
+    constexpr uint32_t SIZE = 1u << 20;
+    slick::ObjectPool<uint32_t> pool(SIZE);
+    uint32_t* first = allocate_run(pool, SIZE);
+    ASSERT_NE(first, nullptr);
+
+    pool.free(first + 100, 10000);
+    EXPECT_EQ(pool.available(), 10000u);
+    for (uint32_t i = 0; i < 10000; ++i) {
+        ASSERT_EQ(pool.allocate(), first + 100 + i);
+    }
+    EXPECT_EQ(pool.available(), 0u);
+    pool.free(first, SIZE);
+    EXPECT_EQ(pool.available(), SIZE);
+}
+
+TEST(RangeFreeTests, RecycleModes) {
+    slick::ObjectPool<Counted> pool(16);
+    Counted* first = allocate_run(pool, 16);
+    ASSERT_NE(first, nullptr);
+    for (uint32_t i = 0; i < 16; ++i) {
+        first[i].value = i + 1;
+    }
+
+    pool.recycle_mode(slick::RecycleMode::ON_FREE);
+    pool.free(first, 8);
+    for (uint32_t i = 0; i < 8; ++i) {
+        EXPECT_EQ(first[i].value, 0u);
+    }
+    EXPECT_EQ(pool.available(), 8u);
+
+    pool.recycle_mode(slick::RecycleMode::BACKGROUND);
+    pool.free(first + 8, 8);
+    EXPECT_EQ(pool.dirty(), 8u);
+    EXPECT_EQ(pool.available(), 8u);
+    EXPECT_EQ(pool.scrub(), 8u);
+    EXPECT_EQ(pool.available(), 16u);
+    for (uint32_t i = 8; i < 16; ++i) {
+        EXPECT_EQ(first[i].value, 0u);
+    }
+}
+
+TEST(RangeFreeTests, ResetAndGrowthAfterBulkFree) {
+    slick::ObjectPool<Order> pool(16, 64, 16);
+    Order* first = allocate_run(pool, 16);
+    ASSERT_NE(first, nullptr);
+    pool.free(first + 4, 8);
+    EXPECT_EQ(pool.available(), 8u);
+
+    // Discards the published run, including its unsplit objects
+    pool.reset();
+    EXPECT_EQ(pool.available(), 16u);
+    std::set<Order*> unique;
+    for (int i = 0; i < 16; ++i) {
+        unique.insert(pool.allocate());
+    }
+    EXPECT_EQ(unique.size(), 16u);
+    EXPECT_EQ(pool.available(), 0u);
+
+    // Growth publishes the new objects as one run
+    EXPECT_EQ(pool.grow(48), 48u);
+    EXPECT_EQ(pool.available(), 48u);
+    for (int i = 0; i < 48; ++i) {
+        Order* obj = pool.allocate();
+        EXPECT_TRUE(pool.owns(obj));
+        unique.insert(obj);
+    }
+    EXPECT_EQ(unique.size(), 64u);
+    EXPECT_EQ(pool.profile().fallbacks, 0u);
+}
+
+TEST(RangeFreeTests, ConcurrentBulkFrees) {
+    constexpr int THREADS = 4;
+    constexpr int HELD = 64;
+    constexpr int ROUNDS = 2000;
+    slick::ObjectPool<Order> pool(THREADS * HELD * 2);
+    std::atomic_int errors{ 0 };
+
+    // Threads return the consecutive stretches of what they hold as runs,
+    // while the others' allocations split those runs
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            std::vector<Order*> held;
+            for (int round = 0; round < ROUNDS; ++round) {
+                for (int i = 0; i < HELD; ++i) {
+                    Order* obj = pool.allocate();
+                    obj->id = (uint64_t(t) << 32) | uint32_t(i);
+                    held.push_back(obj);
+                }
+                for (int i = 0; i < HELD; ++i) {
+                    if (held[i]->id != ((uint64_t(t) << 32) | uint32_t(i))) {
+                        errors.fetch_add(1);
+                    }
+                }
+                // Under contention allocate() may fall back to the heap
+                auto pooled = std::partition(held.begin(), held.end(), [&](Order* obj) { return !pool.owns(obj); });
+                for (auto it = held.begin(); it != pooled; ++it) {
+                    pool.free(*it);
+                }
+                held.erase(held.begin(), pooled);
+                std::sort(held.begin(), held.end());
+                for (size_t i = 0; i < held.size();) {
+                    size_t length = 1;
+                    while (i + length < held.size() && held[i + length] == held[i] + length) {
+                        ++length;
+                    }
+                    pool.free(held[i], static_cast<uint32_t>(length));
+                    i += length;
+                }
+                held.clear();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(errors.load(), 0);
+    EXPECT_EQ(pool.available(), pool.size());
+}
+
+}   // namespace
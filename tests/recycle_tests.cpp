@@ -0,0 +1,213 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#include <gtest/gtest.h>
+#include <slick/pool_scrubber.h>
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Quote {
+    uint64_t id;
+    double bid;
+    double ask;
+};
+
+struct Book {
+    std::vector<int> levels;
+    int recycled = 0;
+
+    void recycle() {
+        levels.clear();     // keep capacity
+        ++recycled;
+    }
+};
+
+struct Named {
+    std::string name = "unset";
+};
+
+// Neither Recyclable nor assignable
+struct Guarded {
+    std::mutex lock;
+    const int kind = 1;
+    uint64_t value = 0;
+};
+
+// Recycling one queues another, so every scrub pass finds work while refilling
+struct Refill {
+    static inline slick::ObjectPool<Refill>* pool = nullptr;
+    static inline std::atomic_bool refilling{ false };
+
+    void recycle() {
+        if (refilling.load()) {
+            pool->free(pool->allocate());
+        }
+    }
+};
+
+}   // namespace
+
+static_assert(slick::Recyclable<Book>);
+static_assert(!slick::Recyclable<Quote>);
+static_assert(slick::recycler<Quote>::zero_fill);
+static_assert(!slick::recycler<Book>::zero_fill);
+static_assert(!slick::recycler<Named>::zero_fill);
+static_assert(slick::PoolRecyclable<Quote> && slick::PoolRecyclable<Book> && slick::PoolRecyclable<Named>);
+static_assert(!slick::PoolRecyclable<Guarded>);
+
+TEST(RecycleTest, NoneKeepsState) {
+    slick::ObjectPool<Quote> pool(1);
+    auto* q = pool.allocate();
+    q->id = 7;
+    pool.free(q);
+    EXPECT_EQ(pool.allocate()->id, 7);
+}
+
+TEST(RecycleTest, NonAssignableType) {
+    slick::ObjectPool<Guarded> pool(2);
+    auto* a = pool.allocate();
+    auto* b = pool.allocate();
+    {
+        std::lock_guard lock(a->lock);
+        a->value = 7;
+    }
+    pool.free(a);
+    pool.free(b);
+    pool.free(pool.allocate(), 1);
+    EXPECT_EQ(pool.available(), 2);
+    EXPECT_EQ(pool.scrub(), 0);
+
+    pool.recycle_mode(slick::RecycleMode::NONE);
+    EXPECT_THROW(pool.recycle_mode(slick::RecycleMode::ON_FREE), std::runtime_error);
+    EXPECT_THROW(pool.recycle_mode(slick::RecycleMode::BACKGROUND), std::runtime_error);
+    EXPECT_EQ(pool.recycle_mode(), slick::RecycleMode::NONE);
+}
+
+TEST(RecycleTest, OnFree) {
+    slick::ObjectPool<Book> pool(1);
+    pool.recycle_mode(slick::RecycleMode::ON_FREE);
+    auto* book = pool.allocate();
+    book->levels.assign(100, 1);
+    pool.free(book);
+    EXPECT_TRUE(book->levels.empty());
+    EXPECT_GE(book->levels.capacity(), 100);
+    EXPECT_EQ(book->recycled, 1);
+}
+
+TEST(RecycleTest, OnAllocate) {
+    slick::ObjectPool<Named> pool(1);
+    pool.recycle_mode(slick::RecycleMode::ON_ALLOCATE);
+    auto* named = pool.allocate();
+    named->name = "order";
+    pool.free(named);
+    EXPECT_EQ(named->name, "order");        // free() leaves it alone
+    EXPECT_EQ(pool.allocate()->name, "unset");
+}
+
+TEST(RecycleTest, BackgroundScrubZeroesRuns) {
+    slick::ObjectPool<Quote> pool(64);
+    pool.recycle_mode(slick::RecycleMode::BACKGROUND);
+
+    std::vector<Quote*> quotes;
+    for (int i = 0; i < 64; ++i) {
+        quotes.push_back(pool.allocate());
+        quotes.back()->id = i + 1;
+        quotes.back()->bid = 1.5;
+    }
+    for (auto* q : quotes) {
+        pool.free(q);
+    }
+    EXPECT_EQ(pool.dirty(), 64);
+    EXPECT_EQ(pool.available(), 0);
+    EXPECT_EQ(quotes[10]->id, 11);          // not recycled yet
+
+    EXPECT_EQ(pool.scrub(16), 64);
+    EXPECT_EQ(pool.dirty(), 0);
+    EXPECT_EQ(pool.available(), 64);
+    EXPECT_EQ(pool.scrub(), 0);
+    for (int i = 0; i < 64; ++i) {
+        auto* q = pool.allocate();
+        EXPECT_TRUE(pool.owns(q));
+        EXPECT_EQ(q->id, 0);
+        EXPECT_EQ(q->bid, 0.0);
+    }
+    EXPECT_EQ(pool.profile().fallbacks, 0);
+}
+
+TEST(RecycleTest, ScrubberThread) {
+    constexpr int THREADS = 2;
+    constexpr int ROUNDS = 2000;
+    slick::ObjectPool<Book> pool(256);
+    pool.recycle_mode(slick::RecycleMode::BACKGROUND);
+    slick::PoolScrubber scrubber(std::chrono::microseconds(20), 32);
+    scrubber.watch(pool);
+    scrubber.start();
+
+    std::vector<std::thread> threads;
+    std::atomic_int dirty_seen{ 0 };
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < ROUNDS; ++i) {
+                auto* book = pool.allocate();
+                if (!book->levels.empty()) {
+                    dirty_seen.fetch_add(1);
+                }
+                book->levels.push_back(i);
+                pool.free(book);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    scrubber.stop();
+
+    EXPECT_EQ(dirty_seen.load(), 0);
+    EXPECT_EQ(pool.dirty(), 0);
+    EXPECT_EQ(pool.available(), 256);
+    EXPECT_GT(scrubber.recycled(), 0);
+}
+
+TEST(RecycleTest, ScrubberStopsUnderSteadyFrees) {
+    slick::ObjectPool<Refill> pool(1024);
+    pool.recycle_mode(slick::RecycleMode::BACKGROUND);
+    Refill::pool = &pool;
+    Refill::refilling.store(true);
+    slick::PoolScrubber scrubber(std::chrono::milliseconds(1), 16);
+    scrubber.watch(pool);
+    pool.free(pool.allocate());
+    scrubber.start();
+    while (scrubber.recycled() < 1000) {
+        std::this_thread::yield();
+    }
+
+    std::promise<void> stopped;
+    auto done = stopped.get_future();
+    std::thread stopper([&] {
+        scrubber.stop();
+        stopped.set_value();
+    });
+    EXPECT_EQ(done.wait_for(std::chrono::seconds(10)), std::future_status::ready)
+        << "PoolScrubber::stop() blocked behind a steady dirty list";
+    // Once the refills stop, a blocked stop() gets through as well
+    Refill::refilling.store(false);
+    stopper.join();
+    pool.scrub();
+    EXPECT_EQ(pool.dirty(), 0);
+    EXPECT_EQ(pool.available(), 1024);
+}
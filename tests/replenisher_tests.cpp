@@ -0,0 +1,136 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#include <gtest/gtest.h>
+#include <slick/pool_replenisher.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Order {
+    uint64_t id = 0;
+    double price = 0;
+    uint32_t quantity = 0;
+};
+
+}   // namespace
+
+TEST(PoolReplenisherTest, ChecksFollowPolicy) {
+    slick::ObjectPool<Order> pool(16, 256, 0);
+    slick::PoolReplenisher replenisher;
+    replenisher.watch(pool, { .segment_size = 16, .low_water = 4, .prepare_water = 8, .trim_water = 24, .trim_after = 2 });
+
+    // Plenty free: nothing to do
+    EXPECT_EQ(replenisher.check(), 0);
+    EXPECT_EQ(pool.staged(), 0);
+
+    // Approaching exhaustion: stage a segment
+    std::vector<Order*> held;
+    for (int i = 0; i < 10; ++i) {
+        held.push_back(pool.allocate());
+    }
+    EXPECT_EQ(replenisher.check(), 0);
+    EXPECT_EQ(pool.staged(), 16);
+    EXPECT_EQ(pool.size(), 16);
+
+    // Below low water: publish the staged segment
+    for (int i = 0; i < 4; ++i) {
+        held.push_back(pool.allocate());
+    }
+    EXPECT_EQ(replenisher.check(), 1);
+    EXPECT_EQ(pool.size(), 32);
+    EXPECT_EQ(pool.staged(), 0);
+    EXPECT_EQ(replenisher.growths(), 1);
+
+    // Load drops: stage again while busy, then trim after trim_after idle checks
+    EXPECT_EQ(pool.stage(16), 16);
+    for (auto* obj : held) {
+        pool.free(obj);
+    }
+    EXPECT_EQ(replenisher.check(), 0);
+    EXPECT_EQ(pool.staged(), 16);
+    EXPECT_EQ(replenisher.check(), 0);
+    EXPECT_EQ(pool.staged(), 0);
+    EXPECT_EQ(pool.size(), 32);
+}
+
+TEST(PoolReplenisherTest, BackgroundThreadPreventsFallbacks) {
+    slick::ObjectPool<Order> orders(64, 4096, 0);
+    slick::ObjectPool<uint64_t> ids(64, 4096, 0);
+    slick::PoolReplenisher replenisher(std::chrono::microseconds(50));
+    replenisher.watch(orders, { .segment_size = 256 });
+    replenisher.watch(ids, { .segment_size = 256 });
+    replenisher.start();
+
+    std::vector<Order*> held;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (held.size() < 2048 && std::chrono::steady_clock::now() < deadline) {
+        if (orders.available() > 32) {
+            held.push_back(orders.allocate());
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    replenisher.stop();
+
+    EXPECT_EQ(held.size(), 2048);
+    EXPECT_EQ(orders.profile().fallbacks, 0);
+    EXPECT_GE(orders.size(), 2048);
+    EXPECT_GT(replenisher.growths(), 0);
+    EXPECT_EQ(ids.size(), 64);
+    for (auto* obj : held) {
+        EXPECT_TRUE(orders.owns(obj));
+        orders.free(obj);
+    }
+}
+
+TEST(PoolReplenisherTest, StopWhileEveryPassFindsWork) {
+    // Leaked if a call hangs, so a failure does not also hang the test binary
+    auto* maintenance = new slick::detail::MaintenanceThread(std::chrono::milliseconds(1), false);
+    std::atomic_uint64_t calls{ 0 };
+    maintenance->add([&]() -> uint64_t {
+        calls.fetch_add(1, std::memory_order_relaxed);
+        return 1;
+    });
+    maintenance->start();
+    while (calls.load(std::memory_order_relaxed) < 100) {
+        std::this_thread::yield();
+    }
+
+    // Runs fn on another thread; false if it does not return in time
+    auto returns = [](auto fn) {
+        std::promise<void> finished;
+        auto done = finished.get_future();
+        std::thread caller([&fn, &finished] {
+            fn();
+            finished.set_value();
+        });
+        if (done.wait_for(std::chrono::seconds(10)) != std::future_status::ready) {
+            caller.detach();
+            return false;
+        }
+        caller.join();
+        return true;
+    };
+
+    ASSERT_TRUE(returns([&] { maintenance->add([]() -> uint64_t { return 1; }); }));
+    ASSERT_TRUE(returns([&] { EXPECT_EQ(maintenance->run_once(), 2); }));
+    ASSERT_TRUE(returns([&] { maintenance->stop(); })) << "stop() blocked behind passes that keep finding work";
+    const auto after_stop = calls.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_EQ(calls.load(), after_stop);
+    delete maintenance;
+}
@@ -0,0 +1,122 @@
+/********************************************************************************
+ * Copyright (c) 2025 SlickQuant
+ * All rights reserved
+ *
+ * This file is part of the slick_object_pool. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively under
+ * the terms of the MIT license which is available at
+ * https://github.com/SlickQuant/slick_object_pool/blob/main/LICENSE
+ *
+ ********************************************************************************/
+
+#include <gtest/gtest.h>
+#include <slick/soa_object_pool.h>
+
+#include <numeric>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Hot {
+    double price = 0;
+    uint32_t qty = 0;
+    uint8_t side = 0;
+};
+
+struct Cold {
+    char client_id[16] = {};
+    std::string tag = "none";
+};
+
+using OrderPool = slick::SoaObjectPool<Hot, Cold>;
+
+}   // namespace
+
+TEST(SoaObjectPoolTest, AllocatesEveryIndexOnce) {
+    OrderPool pool(64);
+    EXPECT_EQ(pool.size(), 64);
+    EXPECT_EQ(pool.available(), 64);
+
+    std::set<uint32_t> ids;
+    for (int i = 0; i < 64; ++i) {
+        auto id = pool.allocate();
+        ASSERT_TRUE(pool.owns(id));
+        ids.insert(id);
+    }
+    EXPECT_EQ(ids.size(), 64);
+    EXPECT_EQ(pool.available(), 0);
+    EXPECT_EQ(pool.allocate(), OrderPool::npos);
+
+    pool.free(17);
+    EXPECT_EQ(pool.allocate(), 17);
+}
+
+TEST(SoaObjectPoolTest, GroupsAreSeparateDenseArrays) {
+    OrderPool pool(256);
+    auto hot = pool.array<Hot>();
+    auto cold = pool.array<Cold>();
+    ASSERT_EQ(hot.size(), 256);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(hot.data()) % 64, 0);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(cold.data()) % 64, 0);
+    EXPECT_EQ(cold[3].tag, "none");
+
+    std::vector<uint32_t> ids;
+    for (int i = 0; i < 100; ++i) {
+        auto id = pool.allocate();
+        pool.get<Hot>(id) = { 10.0 + i, 2, 'B' };
+        pool.get<1>(id).tag = "order";
+        ids.push_back(id);
+    }
+    EXPECT_EQ(&pool.get<Hot>(ids[5]), &hot[ids[5]]);
+    EXPECT_EQ(pool.get<Cold>(ids[5]).tag, "order");
+
+    double notional = 0;
+    for (const auto& h : pool.array<Hot>()) {
+        notional += h.price * h.qty;
+    }
+    EXPECT_DOUBLE_EQ(notional, 2 * (100 * 10.0 + 99 * 100 / 2));
+
+    constexpr auto usage = OrderPool::footprint(256);
+    static_assert(usage.payload_bytes == 256 * (sizeof(Hot) + sizeof(Cold)));
+    EXPECT_EQ(pool.memory_usage().total_bytes(), usage.total_bytes());
+}
+
+TEST(SoaObjectPoolTest, ConcurrentAllocateFree) {
+    constexpr int NUM_THREADS = 4;
+    constexpr int ROUNDS = 2000;
+    constexpr int HELD = 16;
+    OrderPool pool(64);
+    std::vector<std::atomic_int> owners(64);
+
+    std::vector<std::thread> threads;
+    std::atomic_int errors{ 0 };
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            std::vector<uint32_t> held;
+            for (int round = 0; round < ROUNDS; ++round) {
+                for (int i = 0; i < HELD; ++i) {
+                    auto id = pool.allocate();
+                    if (id == OrderPool::npos) {
+                        continue;
+                    }
+                    if (owners[id].exchange(t + 1) != 0) {
+                        errors.fetch_add(1);
+                    }
+                    held.push_back(id);
+                }
+                for (auto id : held) {
+                    owners[id].store(0);
+                    pool.free(id);
+                }
+                held.clear();
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(errors.load(), 0);
+    EXPECT_EQ(pool.available(), 64);
+}
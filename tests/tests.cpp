@@ -19,6 +19,9 @@
 #include <algorithm>
 #include <random>
 #include <set>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
 
 // Test structures
 struct SimpleStruct {
@@ -37,6 +40,39 @@ struct AlignedStruct {
     double data[7];  // Fill rest of cache line
 };
 
+// Counts live instances; the construction numbered throw_at throws
+struct ThrowingStruct {
+    static inline int live = 0;
+    static inline int throw_at = -1;   // -1 = never
+
+    ThrowingStruct() {
+        if (throw_at-- == 0) {
+            throw std::runtime_error("ThrowingStruct");
+        }
+        ++live;
+    }
+    ~ThrowingStruct() {
+        --live;
+    }
+};
+
+// Prints the CAS contention profile of a pool (no-op unless SLICK_OBJECT_POOL_PROFILE_CAS)
+template<typename T>
+void print_cas_profile(const slick::ObjectPool<T>& pool) {
+    if constexpr (slick::ObjectPool<T>::cas_profiling_enabled) {
+        auto profile = pool.cas_profile();
+        for (size_t i = 0; i < slick::CasProfile::SITE_COUNT; ++i) {
+            const auto& site = profile.sites[i];
+            std::cout << "  " << slick::CasProfile::site_name(i) << ": " << site.operations << " ops, "
+                      << site.average_attempts() << " attempts/op, " << site.retry_ns << " ns retrying |";
+            for (size_t b = 0; b < slick::CasSiteProfile::HISTOGRAM_BUCKETS; ++b) {
+                std::cout << " " << slick::CasSiteProfile::bucket_lower_bound(b) << "+:" << site.histogram[b];
+            }
+            std::cout << std::endl;
+        }
+    }
+}
+
 // Test fixture
 class ObjectPoolTest : public ::testing::Test {
 protected:
@@ -57,6 +93,21 @@ TEST_F(ObjectPoolTest, ConstructorLocalMemory) {
     EXPECT_EQ(pool.size(), 256);
 }
 
+TEST_F(ObjectPoolTest, ConstructorThrowDestroysBuiltObjects) {
+    // The sixth object throws: the five built before it are destroyed and,
+    // under ASan, a leaked buffer would be reported
+    ThrowingStruct::throw_at = 5;
+    EXPECT_THROW(slick::ObjectPool<ThrowingStruct>(16, 64, 16), std::runtime_error);
+    EXPECT_EQ(ThrowingStruct::live, 0);
+
+    ThrowingStruct::throw_at = -1;
+    {
+        slick::ObjectPool<ThrowingStruct> pool(16);
+        EXPECT_EQ(ThrowingStruct::live, 16);
+    }
+    EXPECT_EQ(ThrowingStruct::live, 0);
+}
+
 TEST_F(ObjectPoolTest, AllocateAndFreeBasic) {
     slick::ObjectPool<SimpleStruct> pool(256);
 
@@ -264,6 +315,370 @@ TEST_F(ObjectPoolTest, ConcurrentStressTest) {
     EXPECT_EQ(total_allocations.load(), total_deallocations.load());
 }
 
+TEST_F(ObjectPoolTest, CasProfile) {
+    constexpr int ITERATIONS = 100;
+    slick::ObjectPool<SimpleStruct> pool(64);
+
+    for (int i = 0; i < ITERATIONS; ++i) {
+        pool.free(pool.allocate());
+    }
+
+    auto profile = pool.cas_profile();
+    if constexpr (slick::ObjectPool<SimpleStruct>::cas_profiling_enabled) {
+        // Single thread: every CAS succeeds on the first attempt
+        EXPECT_EQ(profile[slick::CasProfile::CONSUME].operations, ITERATIONS);
+        EXPECT_EQ(profile[slick::CasProfile::CONSUME].histogram[0], ITERATIONS);
+
+        pool.reset_cas_profile();
+        EXPECT_EQ(pool.cas_profile()[slick::CasProfile::CONSUME].operations, 0);
+    } else {
+        for (const auto& site : profile.sites) {
+            EXPECT_EQ(site.operations, 0);
+        }
+    }
+
+    EXPECT_EQ(slick::CasSiteProfile::bucket_of(1), 0);
+    EXPECT_EQ(slick::CasSiteProfile::bucket_of(2), 1);
+    EXPECT_EQ(slick::CasSiteProfile::bucket_of(4), 2);
+    EXPECT_EQ(slick::CasSiteProfile::bucket_of(5), 3);
+    EXPECT_EQ(slick::CasSiteProfile::bucket_of(1000), slick::CasSiteProfile::HISTOGRAM_BUCKETS - 1);
+    EXPECT_EQ(slick::CasSiteProfile::bucket_lower_bound(3), 5);
+}
+
+TEST_F(ObjectPoolTest, AllocationTrace) {
+    auto path = (std::filesystem::temp_directory_path() / "slick_object_pool_test.trace").string();
+    slick::ObjectPool<SimpleStruct> pool(4);
+    {
+        slick::AllocationTrace trace(path, 2);  // tiny buffer to exercise block writes
+        pool.trace(&trace);
+
+        std::vector<SimpleStruct*> objects;
+        for (int i = 0; i < 5; ++i) {
+            objects.push_back(pool.allocate());  // 5th comes from the heap
+        }
+        EXPECT_TRUE(pool.owns(objects[0]));
+        EXPECT_FALSE(pool.owns(objects[4]));
+        for (auto* obj : objects) {
+            pool.free(obj);
+        }
+
+        std::thread([&] { pool.free(pool.allocate()); }).join();
+        pool.trace(nullptr);
+        pool.free(pool.allocate());  // not recorded
+        trace.close();
+        EXPECT_EQ(trace.events(), 12);
+    }
+
+    auto [header, events] = slick::AllocationTrace::load(path);
+    std::filesystem::remove(path);
+    EXPECT_EQ(header.capacity, 4);
+    EXPECT_EQ(header.object_size, sizeof(SimpleStruct));
+    EXPECT_EQ(header.threads, 2);
+    ASSERT_EQ(events.size(), 12);
+    EXPECT_TRUE(std::is_sorted(events.begin(), events.end(),
+        [](const auto& a, const auto& b) { return a.timestamp_ns < b.timestamp_ns; }));
+
+    EXPECT_EQ(events[0].type, slick::AllocationTrace::ALLOCATE);
+    EXPECT_EQ(events[0].object, 0);
+    EXPECT_EQ(events[4].type, slick::AllocationTrace::ALLOCATE_HEAP);
+    EXPECT_NE(events[4].object & slick::AllocationTrace::HEAP_OBJECT, 0);
+    EXPECT_EQ(events[8].type, slick::AllocationTrace::FREE);
+    EXPECT_EQ(events[9].type, slick::AllocationTrace::FREE_HEAP);
+    EXPECT_EQ(events[9].object, events[4].object);
+    EXPECT_EQ(events[10].thread, 1);
+    EXPECT_EQ(events[11].thread, 1);
+}
+
+TEST_F(ObjectPoolTest, MemoryFootprint) {
+    using Pool = slick::ObjectPool<LargeStruct>;
+    constexpr auto usage = Pool::footprint(1024);
+    static_assert(usage.capacity == 1024);
+    static_assert(usage.payload_bytes == 1024 * sizeof(LargeStruct));
+
+    // Per object: one 8-byte ring slot on top of the object
+    auto small = Pool::footprint(1024);
+    auto large = Pool::footprint(2048);
+    EXPECT_EQ(large.total_bytes() - small.total_bytes(), 1024 * (sizeof(LargeStruct) + 8));
+    EXPECT_GE(small.metadata_bytes, 1024 * 8);
+    EXPECT_GT(small.padding_bytes, 0);      // cache-line aligned counters
+    EXPECT_GT(small.overhead_per_object(), sizeof(void*));
+    EXPECT_DOUBLE_EQ(small.bytes_per_object(), static_cast<double>(small.total_bytes()) / 1024);
+
+    Pool pool(1024);
+    auto runtime = pool.memory_usage();
+    EXPECT_EQ(runtime.total_bytes(), small.total_bytes());
+    EXPECT_EQ(runtime.padding_bytes, small.padding_bytes);
+}
+
+TEST_F(ObjectPoolTest, HighWaterMarkProfile) {
+    auto path = (std::filesystem::temp_directory_path() / "slick_object_pool_test.profile").string();
+    std::filesystem::remove(path);
+
+    {
+        // No profile yet: default size, profile written on destruction
+        slick::ObjectPool<SimpleStruct> pool(path, 4);
+        EXPECT_EQ(pool.size(), 4);
+
+        std::vector<SimpleStruct*> objects;
+        for (int i = 0; i < 6; ++i) {
+            objects.push_back(pool.allocate());     // last two from the heap
+        }
+        pool.free(objects.back());
+        objects.pop_back();
+        objects.push_back(pool.allocate());         // heap again, peak unchanged
+
+        auto profile = pool.profile();
+        EXPECT_EQ(profile.capacity, 4);
+        EXPECT_EQ(profile.high_water_mark, 6);
+        EXPECT_EQ(profile.fallbacks, 3);
+        for (auto* obj : objects) {
+            pool.free(obj);
+        }
+        EXPECT_EQ(pool.profile().high_water_mark, 6);
+    }
+
+    slick::PoolProfile saved;
+    ASSERT_TRUE(slick::PoolProfile::load(path, saved));
+    EXPECT_EQ(saved.high_water_mark, 6);
+    EXPECT_EQ(saved.fallbacks, 3);
+    EXPECT_EQ(saved.recommended_capacity(0.25), 8);     // 6 * 1.25 = 7.5 -> 8
+    EXPECT_EQ(saved.recommended_capacity(0.5), 16);     // 9 -> 16
+
+    {
+        // Next run sizes itself from the profile and shrinks again with less demand
+        slick::ObjectPool<SimpleStruct> pool(path, 4);
+        EXPECT_EQ(pool.size(), 8);
+        pool.free(pool.allocate());
+        EXPECT_EQ(pool.profile().high_water_mark, 1);
+        EXPECT_EQ(pool.profile().fallbacks, 0);
+    }
+    EXPECT_EQ(slick::ObjectPool<SimpleStruct>::tuned_capacity(path, 4), 2);
+    EXPECT_FALSE(std::filesystem::exists(path + ".tmp"));
+    std::filesystem::remove(path);
+
+    slick::ObjectPool<SimpleStruct> pool(16);
+    auto* held = pool.allocate();
+    pool.free(pool.allocate());
+    pool.reset_profile();
+    EXPECT_EQ(pool.profile().high_water_mark, 1);
+    pool.free(held);
+
+    // Without tracking, only heap fallbacks move the high-water mark
+    slick::ObjectPool<SimpleStruct> untracked(4);
+    EXPECT_FALSE(untracked.tracks_high_water_mark());
+    std::vector<SimpleStruct*> objects;
+    for (int i = 0; i < 3; ++i) {
+        objects.push_back(untracked.allocate());
+    }
+    EXPECT_EQ(untracked.profile().high_water_mark, 0);
+    for (int i = 0; i < 2; ++i) {
+        objects.push_back(untracked.allocate());
+    }
+    EXPECT_EQ(untracked.profile().high_water_mark, 5);
+    for (auto* obj : objects) {
+        untracked.free(obj);
+    }
+    untracked.track_high_water_mark(true);
+    untracked.reset_profile();
+    untracked.free(untracked.allocate());
+    EXPECT_EQ(untracked.profile().high_water_mark, 1);
+}
+
+TEST_F(ObjectPoolTest, GrowOnExhaustion) {
+    slick::ObjectPool<SimpleStruct> pool(4, 16, 4);
+    EXPECT_EQ(pool.size(), 4);
+    EXPECT_EQ(pool.max_size(), 16);
+
+    std::vector<SimpleStruct*> objects;
+    for (int i = 0; i < 16; ++i) {
+        objects.push_back(pool.allocate());
+        EXPECT_TRUE(pool.owns(objects.back()));
+    }
+    EXPECT_EQ(pool.size(), 16);
+    EXPECT_EQ(pool.available(), 0);
+    EXPECT_EQ(pool.profile().fallbacks, 0);
+
+    // At max_size the pool falls back to the heap
+    auto* heap = pool.allocate();
+    EXPECT_FALSE(pool.owns(heap));
+    pool.free(heap);
+
+    std::set<SimpleStruct*> unique(objects.begin(), objects.end());
+    EXPECT_EQ(unique.size(), 16);
+    for (auto* obj : objects) {
+        pool.free(obj);
+    }
+    EXPECT_EQ(pool.available(), 16);
+}
+
+TEST_F(ObjectPoolTest, StageGrowTrim) {
+    slick::ObjectPool<LargeStruct> pool(8, 64, 0);   // no inline growth
+
+    EXPECT_EQ(pool.stage(8), 8);
+    EXPECT_EQ(pool.staged(), 8);
+    EXPECT_EQ(pool.size(), 8);                       // staged objects are not published
+    EXPECT_GT(pool.memory_usage().payload_bytes, pool.footprint(8, 64).payload_bytes);
+
+    EXPECT_EQ(pool.grow(4), 4);                      // taken from the staged objects
+    EXPECT_EQ(pool.staged(), 4);
+    EXPECT_EQ(pool.size(), 12);
+    EXPECT_EQ(pool.grow(8), 8);                      // 4 staged + 4 constructed
+    EXPECT_EQ(pool.staged(), 0);
+    EXPECT_EQ(pool.size(), 20);
+
+    EXPECT_EQ(pool.stage(100), 44);                  // limited by max_size
+    EXPECT_EQ(pool.trim_staged(), 44);
+    EXPECT_EQ(pool.staged(), 0);
+    EXPECT_EQ(pool.grow(100), 44);
+    EXPECT_EQ(pool.grow(1), 0);
+    EXPECT_EQ(pool.size(), 64);
+
+    std::vector<LargeStruct*> objects;
+    for (int i = 0; i < 64; ++i) {
+        objects.push_back(pool.allocate());
+        EXPECT_TRUE(pool.owns(objects.back()));
+    }
+    for (auto* obj : objects) {
+        pool.free(obj);
+    }
+
+    pool.reset();
+    EXPECT_EQ(pool.size(), 64);
+    EXPECT_EQ(pool.available(), 64);
+}
+
+TEST_F(ObjectPoolTest, ConcurrentGrowth) {
+    constexpr int NUM_THREADS = 4;
+    constexpr int HELD = 64;
+    slick::ObjectPool<SimpleStruct> pool(16, 1024, 16);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&] {
+            for (int round = 0; round < 50; ++round) {
+                std::vector<SimpleStruct*> held;
+                for (int i = 0; i < HELD; ++i) {
+                    held.push_back(pool.allocate());
+                }
+                for (auto* obj : held) {
+                    pool.free(obj);
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    EXPECT_LE(pool.size(), 1024);
+    EXPECT_GE(pool.size(), 16);
+    EXPECT_EQ(pool.available(), pool.size());
+}
+
+TEST_F(ObjectPoolTest, ResetStartsNewGeneration) {
+    slick::ObjectPool<SimpleStruct> pool(8);
+
+    for (int round = 0; round < 3; ++round) {
+        std::vector<SimpleStruct*> held;
+        for (int i = 0; i < 5; ++i) {
+            held.push_back(pool.allocate());
+        }
+        pool.free(held[0]);                 // published in this generation, then discarded
+        pool.reset();
+        EXPECT_EQ(pool.available(), 8);
+
+        std::set<SimpleStruct*> unique;
+        for (int i = 0; i < 8; ++i) {
+            auto* obj = pool.allocate();
+            EXPECT_TRUE(pool.owns(obj));
+            unique.insert(obj);
+        }
+        EXPECT_EQ(unique.size(), 8);
+        EXPECT_EQ(pool.available(), 0);
+        for (auto* obj : unique) {
+            pool.free(obj);
+        }
+        EXPECT_EQ(pool.available(), 8);
+    }
+    EXPECT_EQ(pool.profile().fallbacks, 0);
+}
+
+TEST_F(ObjectPoolTest, ConcurrentReset) {
+    constexpr int NUM_THREADS = 4;
+    constexpr int POOL_SIZE = 64;
+    slick::ObjectPool<SimpleStruct> pool(POOL_SIZE);
+    std::atomic_bool stop{ false };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                // Frees straddling a reset break the reset() contract on
+                // purpose; the final reset must still restore the pool
+                pool.free(pool.allocate());
+            }
+        });
+    }
+    for (int i = 0; i < 1000; ++i) {
+        pool.reset();
+    }
+    stop = true;
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    // Once quiescent, a final reset leaves exactly the pool's objects available
+    pool.reset();
+    std::set<SimpleStruct*> unique;
+    for (int i = 0; i < POOL_SIZE; ++i) {
+        auto* obj = pool.allocate();
+        EXPECT_TRUE(pool.owns(obj));
+        unique.insert(obj);
+    }
+    EXPECT_EQ(unique.size(), POOL_SIZE);
+    auto* extra = pool.allocate();
+    EXPECT_FALSE(pool.owns(extra));
+    pool.free(extra);
+}
+
+TEST_F(ObjectPoolTest, ResetAgainstStraddlingFree) {
+    // free() is reserve() then publish() on the pool's detail::PoolRing and
+    // cannot be paused in between, so both orders a free() straddling
+    // reset() can take are forced on a PoolRing directly
+    constexpr uint32_t SIZE = 8;
+    constexpr uint32_t npos = slick::detail::PoolRing::npos;
+    slick::detail::PoolRing ring(SIZE, SIZE);
+    auto drain = [&ring] {
+        std::multiset<uint32_t> handed;
+        for (uint32_t object; (object = ring.consume()) != npos;) {
+            handed.insert(object);
+        }
+        return handed;
+    };
+    std::vector<uint32_t> held;
+    for (int i = 0; i < 3; ++i) {
+        held.push_back(ring.consume());
+    }
+
+    // Index reserved before the reset: the publish is stale and discarded
+    const uint64_t index = ring.reserve();
+    ring.reset(SIZE);
+    ring.publish(index, held[0]);
+    auto handed = drain();
+    EXPECT_EQ(handed.size(), SIZE);
+    for (uint32_t object = 0; object < SIZE; ++object) {
+        EXPECT_EQ(handed.count(object), 1u) << "object " << object;
+    }
+
+    // Index reserved after the reset: the object lands in the new generation
+    // next to its implicit copy in the initial fill and is handed out twice,
+    // which is why free() must not overlap reset()
+    ring.reset(SIZE);
+    ring.publish(ring.reserve(), held[0]);
+    handed = drain();
+    EXPECT_EQ(handed.size(), SIZE + 1);
+    EXPECT_EQ(handed.count(held[0]), 2u);
+}
+
 // ============================================================================
 // Performance Tests
 // ============================================================================
@@ -289,6 +704,7 @@ TEST_F(ObjectPoolTest, DISABLED_BenchmarkSingleThreaded) {
 
     std::cout << "Single-threaded performance: " << ns_per_op << " ns/op" << std::endl;
     std::cout << "Throughput: " << (ITERATIONS * 1e9 / duration.count()) << " ops/sec" << std::endl;
+    print_cas_profile(pool);
 }
 
 TEST_F(ObjectPoolTest, DISABLED_BenchmarkMultiThreaded) {
@@ -326,6 +742,7 @@ TEST_F(ObjectPoolTest, DISABLED_BenchmarkMultiThreaded) {
     std::cout << "Multi-threaded (" << NUM_THREADS << " threads) performance: "
               << ns_per_op << " ns/op" << std::endl;
     std::cout << "Throughput: " << (total_ops * 1e9 / duration.count()) << " ops/sec" << std::endl;
+    print_cas_profile(pool);
 }
 
 // ============================================================================